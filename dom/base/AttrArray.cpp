@@ -493,6 +493,33 @@ AttrArray::EnsureCapacityToClone(const AttrArray& aOther)
   return NS_OK;
 }
 
+nsresult
+AttrArray::EnsureCapacityForNewAttrs(uint32_t aCount)
+{
+  if (mImpl || !aCount) {
+    return NS_OK;
+  }
+
+  // Unlike when cloning, nothing bounds aCount yet, so check for overflow
+  // before allocating.
+  CheckedUint32 sizeInBytes = aCount;
+  sizeInBytes *= sizeof(InternalAttr);
+  sizeInBytes += sizeof(Impl);
+  if (!sizeInBytes.isValid()) {
+    return NS_ERROR_OUT_OF_MEMORY;
+  }
+
+  mImpl.reset(static_cast<Impl*>(malloc(
+    Impl::AllocationSizeForAttributes(aCount))));
+  NS_ENSURE_TRUE(mImpl, NS_ERROR_OUT_OF_MEMORY);
+
+  mImpl->mMappedAttrs = nullptr;
+  mImpl->mCapacity = aCount;
+  mImpl->mAttrCount = 0;
+
+  return NS_OK;
+}
+
 bool
 AttrArray::GrowBy(uint32_t aGrowSize)
 {
@@ -127,6 +127,13 @@ public:
   // unmapped attributes of |aOther|.
   nsresult EnsureCapacityToClone(const AttrArray& aOther);
 
+  // Allocates exactly enough space for |aCount| unmapped attributes if no
+  // buffer exists yet, so that callers which know the final attribute count
+  // up front (e.g. the parser) don't pay for the default growth slack.
+  // Does nothing if a buffer has already been allocated. Mapped attributes
+  // are stored in nsMappedAttributes and should not be counted.
+  nsresult EnsureCapacityForNewAttrs(uint32_t aCount);
+
   struct InternalAttr
   {
     nsAttrName mName;
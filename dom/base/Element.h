@@ -746,6 +746,18 @@ public:
    */
   nsresult SetSingleClassFromParser(nsAtom* aSingleClassName);
 
+  /**
+   * Reserve storage for aCount unmapped attributes that are about to be set,
+   * so that the attribute buffer is allocated once at its final size.  Only
+   * has an effect if no attributes have been set yet.  This is just a hint:
+   * if the allocation fails, setting the attributes grows the buffer (and
+   * reports errors) as usual.
+   */
+  void EnsureAttrCapacity(uint32_t aCount)
+  {
+    mAttrs.EnsureCapacityForNewAttrs(aCount);
+  }
+
   // aParsedValue receives the old value of the attribute. That's useful if
   // either the input or output value of aParsedValue is StoresOwnData.
   nsresult SetParsedAttr(int32_t aNameSpaceID, nsAtom* aName, nsAtom* aPrefix,
@@ -1077,6 +1077,27 @@ nsCacheableFuncStringHTMLCollection::WrapObject(JSContext *cx, JS::Handle<JSObje
   return HTMLCollection_Binding::Wrap(cx, this, aGivenProto);
 }
 
+void
+nsCacheableFuncStringHTMLCollection::AttributeChanged(Element* aElement,
+                                                      int32_t aNameSpaceID,
+                                                      nsAtom* aAttribute,
+                                                      int32_t aModType,
+                                                      const nsAttrValue* aOldValue)
+{
+  // getElementsByClassName lists only depend on the class attribute, so
+  // changes to any other attribute can't affect whether an element matches.
+  // Frameworks tend to keep many of these lists alive, so avoid re-matching
+  // (and searching mElements) for every unrelated attribute change.
+  if (nsContentUtils::IsClassNameMatchFunc(mFunc) &&
+      (aAttribute != nsGkAtoms::_class || aNameSpaceID != kNameSpaceID_None)) {
+    return;
+  }
+
+  nsCacheableFuncStringContentList::AttributeChanged(aElement,
+                                                     aNameSpaceID, aAttribute,
+                                                     aModType, aOldValue);
+}
+
 //-----------------------------------------------------
 // nsLabelsNodeList
 
@@ -2195,6 +2195,15 @@ public:
                                                                          aClasses);
   }
 
+  /**
+   * Returns whether aFunc is the matching function used by the lists that
+   * GetElementsByClassName returns.
+   */
+  static bool IsClassNameMatchFunc(nsContentListMatchFunc aFunc)
+  {
+    return aFunc == MatchClassNames;
+  }
+
   /**
    * Returns a presshell for this document, if there is one. This will be
    * aDoc's direct presshell if there is one, otherwise we'll look at all
@@ -229,6 +229,7 @@
 #include "nsDOMCaretPosition.h"
 #include "nsViewportInfo.h"
 #include "mozilla/StaticPtr.h"
+#include "mozilla/SystemGroup.h"
 #include "nsITextControlElement.h"
 #include "nsIEditor.h"
 #include "nsIHttpChannelInternal.h"
@@ -1302,6 +1303,20 @@ nsIDocument::SelectorCache::~SelectorCache()
   AgeAllGenerations();
 }
 
+static StaticAutoPtr<nsIDocument::SelectorCache> sSelectorCache;
+
+/* static */ nsIDocument::SelectorCache&
+nsIDocument::GetSelectorCache()
+{
+  MOZ_ASSERT(NS_IsMainThread());
+  if (!sSelectorCache) {
+    sSelectorCache =
+      new SelectorCache(SystemGroup::EventTargetFor(TaskCategory::Other));
+    ClearOnShutdown(&sSelectorCache);
+  }
+  return *sSelectorCache;
+}
+
 void nsIDocument::SelectorCache::NotifyExpired(SelectorCacheKey* aSelector)
 {
   MOZ_ASSERT(NS_IsMainThread());
@@ -1508,14 +1508,10 @@ public:
     nsDataHashtable<nsStringHashKey, SelectorList> mTable;
   };
 
-  SelectorCache& GetSelectorCache() {
-    if (!mSelectorCache) {
-      mSelectorCache =
-        mozilla::MakeUnique<SelectorCache>(
-          EventTargetFor(mozilla::TaskCategory::Other));
-    }
-    return *mSelectorCache;
-  }
+  // Returns the process-wide cache of parsed querySelector{,All} selectors.
+  // Parsing doesn't depend on the document, so all documents (and frames)
+  // issuing the same selector strings share a single parsed list.
+  static SelectorCache& GetSelectorCache();
   // Get the root <html> element, or return null if there isn't one (e.g.
   // if the root isn't <html>)
   Element* GetHtmlElement() const;
@@ -3852,10 +3848,6 @@ private:
   mutable std::bitset<eDeprecatedOperationCount> mDeprecationWarnedAbout;
   mutable std::bitset<eDocumentWarningCount> mDocWarningWarnedAbout;
 
-  // Lazy-initialization to have mDocGroup initialized in prior to the
-  // SelectorCaches.
-  mozilla::UniquePtr<SelectorCache> mSelectorCache;
-
 protected:
   friend class nsDocumentOnStack;
 
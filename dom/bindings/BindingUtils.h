@@ -669,6 +669,33 @@ DestroyProtoAndIfaceCache(JSObject* obj)
   delete protoAndIfaceCache;
 }
 
+// Like GetPerInterfaceObjectHandle, but for callers that have already looked
+// up the current global of aCx.  The common case of the object already being
+// in the cache is handled inline, which keeps reflector creation from paying
+// for an out-of-line call and a second global lookup per object.
+inline JS::Handle<JSObject*>
+GetPerInterfaceObjectHandleForGlobal(JSContext* aCx,
+                                     JS::Handle<JSObject*> aGlobal,
+                                     size_t aSlotId,
+                                     CreateInterfaceObjectsMethod aCreator,
+                                     bool aDefineOnGlobal)
+{
+  MOZ_ASSERT(aGlobal == JS::CurrentGlobalOrNull(aCx));
+
+  if (MOZ_LIKELY(js::GetObjectClass(aGlobal)->flags & JSCLASS_DOM_GLOBAL)) {
+    ProtoAndIfaceCache& protoAndIfaceCache = *GetProtoAndIfaceCache(aGlobal);
+    if (MOZ_LIKELY(protoAndIfaceCache.HasEntryInSlot(aSlotId))) {
+      // See GetPerInterfaceObjectHandle for why this is safe.
+      const JS::Heap<JSObject*>& entrySlot =
+        protoAndIfaceCache.EntrySlotMustExist(aSlotId);
+      MOZ_ASSERT(JS::ObjectIsNotGray(entrySlot));
+      return JS::Handle<JSObject*>::fromMarkedLocation(entrySlot.address());
+    }
+  }
+
+  return GetPerInterfaceObjectHandle(aCx, aSlotId, aCreator, aDefineOnGlobal);
+}
+
 /**
  * Add constants to an object.
  */
@@ -3696,13 +3696,18 @@ def SetImmutablePrototype(descriptor, failureCode):
         failureCode=failureCode)
 
 
-def DeclareProto():
+def DeclareProto(descriptor):
     """
     Declare the canonicalProto and proto we have for our wrapping operation.
+    Expects a "global" that is the current global of aCx to be in scope.
     """
-    return dedent(
+    return fill(
         """
-        JS::Handle<JSObject*> canonicalProto = GetProtoObjectHandle(aCx);
+        JS::Handle<JSObject*> canonicalProto =
+          GetPerInterfaceObjectHandleForGlobal(aCx, global,
+                                               prototypes::id::${name},
+                                               &CreateInterfaceObjects,
+                                               /* aDefineOnGlobal = */ true);
         if (!canonicalProto) {
           return false;
         }
@@ -3720,7 +3725,8 @@ def DeclareProto():
         } else {
           proto = canonicalProto;
         }
-        """)
+        """,
+        name=descriptor.name)
 
 
 class CGWrapWithCacheMethod(CGAbstractMethod):
@@ -3804,7 +3810,7 @@ class CGWrapWithCacheMethod(CGAbstractMethod):
             """,
             nativeType=self.descriptor.nativeType,
             assertInheritance=AssertInheritanceChain(self.descriptor),
-            declareProto=DeclareProto(),
+            declareProto=DeclareProto(self.descriptor),
             createObject=CreateBindingJSObject(self.descriptor, self.properties),
             unforgeable=CopyUnforgeablePropertiesToInstance(self.descriptor,
                                                             failureCode),
@@ -3869,7 +3875,7 @@ class CGWrapNonWrapperCacheMethod(CGAbstractMethod):
             return true;
             """,
             assertions=AssertInheritanceChain(self.descriptor),
-            declareProto=DeclareProto(),
+            declareProto=DeclareProto(self.descriptor),
             createObject=CreateBindingJSObject(self.descriptor, self.properties),
             unforgeable=CopyUnforgeablePropertiesToInstance(self.descriptor,
                                                             failureCode),
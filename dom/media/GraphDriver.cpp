@@ -126,6 +126,12 @@ GraphDriver* GraphDriver::NextDriver()
   return mNextDriver;
 }
 
+bool GraphDriver::HasNextDriverOnThread()
+{
+  MOZ_ASSERT(OnThread());
+  return !!mNextDriver;
+}
+
 GraphDriver* GraphDriver::PreviousDriver()
 {
   MOZ_ASSERT(OnThread() || !ThreadRunning());
@@ -1046,13 +1052,7 @@ AudioCallbackDriver::DataCallback(const AudioDataValue* aInputBuffer,
     return aFrames - 1;
   }
 
-  bool switching = false;
-  {
-    MonitorAutoLock mon(GraphImpl()->GetMonitor());
-    switching = !!NextDriver();
-  }
-
-  if (switching) {
+  if (HasNextDriverOnThread()) {
     mShouldFallbackIfError = false;
     // If the audio stream has not been started by the previous driver or
     // the graph itself, keep it alive.
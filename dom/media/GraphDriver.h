@@ -146,6 +146,11 @@ public:
   // lock is held.
   GraphDriver* NextDriver();
   GraphDriver* PreviousDriver();
+  // Whether a switch to another driver is pending, without taking the graph
+  // monitor. Only valid on the driver's own thread: while a driver is running,
+  // its next driver is only ever set from that thread, so there is no racing
+  // writer. This keeps the audio callback from locking on every iteration.
+  bool HasNextDriverOnThread();
   void SetPreviousDriver(GraphDriver* aPreviousDriver);
 
   /**
@@ -428,6 +428,11 @@ protected:
   // Guess the duration until the next incoming data on aStream will be used
   TimeDuration PredictNextUseForIncomingData(AutoLock&,
                                              MediaCacheStream* aStream);
+  // How far ahead of playback (in seconds) aStream may read, adjusted from
+  // aBaseLimit according to its measured download and playback rates
+  double ReadaheadLimitForStream(AutoLock&,
+                                 MediaCacheStream* aStream,
+                                 int32_t aBaseLimit);
 
   // Truncate the file and index array if there are free blocks at the
   // end
@@ -1222,6 +1227,27 @@ MediaCache::PredictNextUseForIncomingData(AutoLock&, MediaCacheStream* aStream)
       std::min<int64_t>(millisecondsAhead, INT32_MAX));
 }
 
+double
+MediaCache::ReadaheadLimitForStream(AutoLock&,
+                                    MediaCacheStream* aStream,
+                                    int32_t aBaseLimit)
+{
+  MOZ_ASSERT(sThread->IsOnCurrentThread());
+
+  bool reliable = false;
+  double downloadRate = aStream->mDownloadStatistics.GetRate(&reliable);
+  if (!reliable || downloadRate <= 0.0) {
+    return aBaseLimit;
+  }
+
+  // A connection that only just keeps up with playback needs more buffered
+  // data to ride out a stall than one that can refill the buffer quickly.
+  // Scale the limit from 1x (download much faster than playback) up to 2x
+  // (download no faster than playback).
+  double ratio = aStream->mPlaybackBytesPerSecond / downloadRate;
+  return aBaseLimit * (1.0 + std::min(ratio, 1.0));
+}
+
 void
 MediaCache::Update()
 {
@@ -1480,7 +1506,8 @@ MediaCache::Update()
         LOG("Stream %p avoiding wakeup since more data is not needed", stream);
         enableReading = false;
       } else if (stream->mThrottleReadahead &&
-                 predictedNewDataUse.ToSeconds() > readaheadLimit) {
+                 predictedNewDataUse.ToSeconds() >
+                   ReadaheadLimitForStream(lock, stream, readaheadLimit)) {
         // Don't read ahead more than this much
         LOG("Stream %p throttling to avoid reading ahead too far", stream);
         enableReading = false;
@@ -360,6 +360,7 @@ MediaFormatReader::DecoderData::Flush()
     return;
   }
   mDecodeRequest.DisconnectIfExists();
+  mDeferredDemuxFailure.reset();
   mDrainRequest.DisconnectIfExists();
   mDrainState = DrainState::None;
   CancelWaitingForKey();
@@ -1148,6 +1149,7 @@ MediaFormatReader::Shutdown()
   }
 
   if (HasAudio()) {
+    ReportDemuxStarvations(TrackInfo::kAudioTrack);
     mAudio.ResetDemuxer();
     mAudio.mTrackDemuxer->BreakCycles();
     mAudio.mTrackDemuxer = nullptr;
@@ -1156,6 +1158,7 @@ MediaFormatReader::Shutdown()
   }
 
   if (HasVideo()) {
+    ReportDemuxStarvations(TrackInfo::kVideoTrack);
     mVideo.ResetDemuxer();
     mVideo.mTrackDemuxer->BreakCycles();
     mVideo.mTrackDemuxer = nullptr;
@@ -1637,6 +1640,26 @@ MediaFormatReader::OnDemuxFailed(TrackType aTrack, const MediaResult& aError)
       aError.ErrorName().get());
   auto& decoder = GetDecoderData(aTrack);
   decoder.mDemuxRequest.Complete();
+  if (decoder.mDemuxIsPrefetch) {
+    decoder.mDemuxIsPrefetch = false;
+    if (decoder.mDecodeRequest.Exists() &&
+        aError.Code() != NS_ERROR_DOM_MEDIA_CANCELED) {
+      // This demux was issued ahead of the decoder. Don't drain or error out
+      // the track while the previous sample is still being decoded; the
+      // failure is handled once that decode completes.
+      decoder.mDeferredDemuxFailure = Some(aError);
+      return;
+    }
+  }
+  HandleDemuxFailure(aTrack, aError);
+}
+
+void
+MediaFormatReader::HandleDemuxFailure(TrackType aTrack,
+                                      const MediaResult& aError)
+{
+  MOZ_ASSERT(OnTaskQueue());
+  auto& decoder = GetDecoderData(aTrack);
   switch (aError.Code()) {
     case NS_ERROR_DOM_MEDIA_END_OF_STREAM:
       DDLOG(DDLogCategory::Log,
@@ -1723,6 +1746,12 @@ MediaFormatReader::OnVideoDemuxCompleted(
         "video_demuxed_samples",
         uint64_t(aSamples->mSamples.Length()));
   mVideo.mDemuxRequest.Complete();
+  if (mVideo.mDemuxIsPrefetch && !mVideo.mDecodeRequest.Exists()) {
+    // The decoder finished with its previous sample before the sample
+    // prefetched for it was demuxed.
+    NoteDemuxStarvation(TrackInfo::kVideoTrack);
+  }
+  mVideo.mDemuxIsPrefetch = false;
   mVideo.mQueuedSamples.AppendElements(aSamples->mSamples);
   ScheduleUpdate(TrackInfo::kVideoTrack);
 }
@@ -1809,6 +1838,12 @@ MediaFormatReader::OnAudioDemuxCompleted(
         "audio_demuxed_samples",
         uint64_t(aSamples->mSamples.Length()));
   mAudio.mDemuxRequest.Complete();
+  if (mAudio.mDemuxIsPrefetch && !mAudio.mDecodeRequest.Exists()) {
+    // The decoder finished with its previous sample before the sample
+    // prefetched for it was demuxed.
+    NoteDemuxStarvation(TrackInfo::kAudioTrack);
+  }
+  mAudio.mDemuxIsPrefetch = false;
   mAudio.mQueuedSamples.AppendElements(aSamples->mSamples);
   ScheduleUpdate(TrackInfo::kAudioTrack);
 }
@@ -2116,7 +2151,45 @@ MediaFormatReader::RequestDemuxSamples(TrackType aTrack)
     return;
   }
 
+  if (!decoder.mFlushed && !decoder.mDecodeRequest.Exists()) {
+    // The decoder has been fed since the last flush and is now idle until
+    // this demux completes.
+    NoteDemuxStarvation(aTrack);
+  }
+
   LOGV("Requesting extra demux %s", TrackTypeToStr(aTrack));
+  decoder.mDemuxIsPrefetch = false;
+  if (aTrack == TrackInfo::kVideoTrack) {
+    DoDemuxVideo();
+  } else {
+    DoDemuxAudio();
+  }
+}
+
+void
+MediaFormatReader::PrefetchDemuxedSamples(TrackType aTrack)
+{
+  MOZ_ASSERT(OnTaskQueue());
+  auto& decoder = GetDecoderData(aTrack);
+
+  // Only demux ahead while a sample is being decoded in steady state. Seeking,
+  // skipping, draining and waiting for data all demux on demand as before, and
+  // at most one sample is ever held back for the decoder.
+  // A skip that starts later cancels the prefetch before moving the demuxer.
+  if (!decoder.mDecodeRequest.Exists() ||
+      !decoder.mQueuedSamples.IsEmpty() ||
+      decoder.mDemuxRequest.Exists() ||
+      decoder.mDemuxEOS ||
+      decoder.mWaitingForData ||
+      decoder.mTimeThreshold.isSome() ||
+      decoder.HasPendingDrain() ||
+      decoder.HasFatalError() ||
+      (aTrack == TrackInfo::kVideoTrack && mSkipRequest.Exists())) {
+    return;
+  }
+
+  LOGV("Prefetching demux %s", TrackTypeToStr(aTrack));
+  decoder.mDemuxIsPrefetch = true;
   if (aTrack == TrackInfo::kVideoTrack) {
     DoDemuxVideo();
   } else {
@@ -2124,6 +2197,46 @@ MediaFormatReader::RequestDemuxSamples(TrackType aTrack)
   }
 }
 
+void
+MediaFormatReader::NoteDemuxStarvation(TrackType aTrack)
+{
+  MOZ_ASSERT(OnTaskQueue());
+  auto& decoder = GetDecoderData(aTrack);
+  decoder.mNumDemuxStarvations++;
+  DDLOG(DDLogCategory::Log,
+        aTrack == TrackInfo::kVideoTrack ? "video_demux_starved"
+                                         : "audio_demux_starved",
+        DDNoValue{});
+}
+
+void
+MediaFormatReader::ReportDemuxStarvations(TrackType aTrack)
+{
+  MOZ_ASSERT(OnTaskQueue());
+  auto& decoder = GetDecoderData(aTrack);
+  if (!decoder.mNumSamplesOutputTotal) {
+    return;
+  }
+  Telemetry::Accumulate(
+    Telemetry::HistogramID::MEDIA_DEMUX_STARVATION_COUNT,
+    aTrack == TrackInfo::kVideoTrack ? NS_LITERAL_CSTRING("video")
+                                     : NS_LITERAL_CSTRING("audio"),
+    uint32_t(std::min<uint64_t>(decoder.mNumDemuxStarvations, UINT32_MAX)));
+}
+
+void
+MediaFormatReader::CancelPrefetch(TrackType aTrack)
+{
+  MOZ_ASSERT(OnTaskQueue());
+  auto& decoder = GetDecoderData(aTrack);
+  if (decoder.mDemuxIsPrefetch) {
+    decoder.mDemuxRequest.DisconnectIfExists();
+    decoder.mDemuxIsPrefetch = false;
+  }
+  decoder.mDeferredDemuxFailure.reset();
+  decoder.mQueuedSamples.Clear();
+}
+
 void
 MediaFormatReader::DecodeDemuxedSamples(TrackType aTrack,
                                         MediaRawData* aSample)
@@ -2153,6 +2266,11 @@ MediaFormatReader::DecodeDemuxedSamples(TrackType aTrack,
            (const MediaDataDecoder::DecodedData& aResults) {
              decoder.mDecodeRequest.Complete();
              self->NotifyNewOutput(aTrack, aResults);
+             if (decoder.mDeferredDemuxFailure) {
+               MediaResult error = decoder.mDeferredDemuxFailure.ref();
+               decoder.mDeferredDemuxFailure.reset();
+               self->HandleDemuxFailure(aTrack, error);
+             }
 
              // When we recovered from a GPU crash and get the first decoded
              // frame, report the recovery time telemetry.
@@ -2163,6 +2281,9 @@ MediaFormatReader::DecodeDemuxedSamples(TrackType aTrack,
            },
            [self, aTrack, &decoder](const MediaResult& aError) {
              decoder.mDecodeRequest.Complete();
+             // Recovering from the decode error demuxes again, which reports
+             // a deferred EOS or WAITING_FOR_DATA anew.
+             decoder.mDeferredDemuxFailure.reset();
              self->NotifyError(aTrack, aError);
            })
     ->Track(decoder.mDecodeRequest);
@@ -2267,6 +2388,8 @@ MediaFormatReader::HandleDemuxedSamples(
   DecodeDemuxedSamples(aTrack, sample);
 
   decoder.mQueuedSamples.RemoveElementAt(0);
+
+  PrefetchDemuxedSamples(aTrack);
 }
 
 void
@@ -2787,6 +2910,7 @@ MediaFormatReader::Reset(TrackType aTrack)
 
   auto& decoder = GetDecoderData(aTrack);
 
+  CancelPrefetch(aTrack);
   decoder.ResetState();
   decoder.Flush();
 
@@ -2821,8 +2945,11 @@ MediaFormatReader::SkipVideoDemuxToNextKeyFrame(TimeUnit aTimeThreshold)
 
   // We've reached SkipVideoDemuxToNextKeyFrame when our decoding is late.
   // As such we can drop all already decoded samples and discard all pending
-  // samples.
+  // samples. The demuxer must not be asked to skip while a demux is still
+  // outstanding.
   DropDecodedSamples(TrackInfo::kVideoTrack);
+  CancelPrefetch(TrackInfo::kVideoTrack);
+  mVideo.mDemuxRequest.DisconnectIfExists();
 
   mVideo.mTrackDemuxer->SkipToNextRandomAccessPoint(aTimeThreshold)
     ->Then(OwnerThread(), __func__, this,
@@ -3336,7 +3463,8 @@ MediaFormatReader::GetMozDebugReaderData(nsACString& aString)
     result += nsPrintfCString(
       "Audio State: ni=%d no=%d wp=%d demuxr=%d demuxq=%u decoder=%d tt=%.1f "
       "tths=%d in=%" PRIu64 " out=%" PRIu64
-      " qs=%u pending=%u wfd=%d eos=%d ds=%d wfk=%d sid=%u\n",
+      " qs=%u pending=%u wfd=%d eos=%d ds=%d wfk=%d sid=%u starved=%" PRIu64
+      "\n",
       NeedInput(mAudio),
       mAudio.HasPromise(),
       !mAudio.mWaitingPromise.IsEmpty(),
@@ -3354,7 +3482,8 @@ MediaFormatReader::GetMozDebugReaderData(nsACString& aString)
       mAudio.mDemuxEOS,
       int32_t(mAudio.mDrainState),
       mAudio.mWaitingForKey,
-      mAudio.mLastStreamSourceID);
+      mAudio.mLastStreamSourceID,
+      mAudio.mNumDemuxStarvations);
   }
 
   result += nsPrintfCString(
@@ -3376,7 +3505,8 @@ MediaFormatReader::GetMozDebugReaderData(nsACString& aString)
     result += nsPrintfCString(
       "Video State: ni=%d no=%d wp=%d demuxr=%d demuxq=%u decoder=%d tt=%.1f "
       "tths=%d in=%" PRIu64 " out=%" PRIu64
-      " qs=%u pending:%u wfd=%d eos=%d ds=%d wfk=%d sid=%u\n",
+      " qs=%u pending:%u wfd=%d eos=%d ds=%d wfk=%d sid=%u starved=%" PRIu64
+      "\n",
       NeedInput(mVideo),
       mVideo.HasPromise(),
       !mVideo.mWaitingPromise.IsEmpty(),
@@ -3394,7 +3524,8 @@ MediaFormatReader::GetMozDebugReaderData(nsACString& aString)
       mVideo.mDemuxEOS,
       int32_t(mVideo.mDrainState),
       mVideo.mWaitingForKey,
-      mVideo.mLastStreamSourceID);
+      mVideo.mLastStreamSourceID,
+      mVideo.mNumDemuxStarvations);
   }
   aString += result;
 }
@@ -281,6 +281,14 @@ private:
   bool UpdateReceivedNewData(TrackType aTrack);
   // Called when new samples need to be demuxed.
   void RequestDemuxSamples(TrackType aTrack);
+  // Demux the next sample while the decoder is busy with the current one.
+  void PrefetchDemuxedSamples(TrackType aTrack);
+  // Drop any prefetched sample and cancel a prefetch still in flight.
+  void CancelPrefetch(TrackType aTrack);
+  // Count a time the decoder had to wait for the demuxer.
+  void NoteDemuxStarvation(TrackType aTrack);
+  // Accumulate the track's demux starvation count into telemetry.
+  void ReportDemuxStarvations(TrackType aTrack);
   // Handle demuxed samples by the input behavior.
   void HandleDemuxedSamples(TrackType aTrack,
                             FrameStatistics::AutoNotifyDecoded& aA);
@@ -372,6 +380,7 @@ private:
       , mWaitingForData(false)
       , mWaitingForKey(false)
       , mReceivedNewData(false)
+      , mDemuxIsPrefetch(false)
       , mFlushing(false)
       , mFlushed(true)
       , mDrainState(DrainState::None)
@@ -382,6 +391,7 @@ private:
       , mNumSamplesOutput(0)
       , mNumSamplesOutputTotal(0)
       , mNumSamplesSkippedTotal(0)
+      , mNumDemuxStarvations(0)
       , mSizeOfQueue(0)
       , mIsHardwareAccelerated(false)
       , mLastStreamSourceID(UINT32_MAX)
@@ -425,6 +435,12 @@ private:
     // Queued demux samples waiting to be decoded.
     nsTArray<RefPtr<MediaRawData>> mQueuedSamples;
     MozPromiseRequestHolder<MediaTrackDemuxer::SamplesPromise> mDemuxRequest;
+    // Set while mDemuxRequest was issued by PrefetchDemuxedSamples, ahead of
+    // the decoder asking for input.
+    bool mDemuxIsPrefetch;
+    // Failure of a prefetched demux that completed while the previous sample
+    // was still being decoded. It is handled once that decode completes.
+    Maybe<MediaResult> mDeferredDemuxFailure;
     // A WaitingPromise is pending if the demuxer is waiting for data or
     // if the decoder is waiting for a key.
     MozPromiseHolder<WaitForDataPromise> mWaitingPromise;
@@ -513,6 +529,9 @@ private:
     uint64_t mNumSamplesOutput;
     uint64_t mNumSamplesOutputTotal;
     uint64_t mNumSamplesSkippedTotal;
+    // Number of times the decoder was ready for its next sample but had to
+    // wait for the demuxer to produce it.
+    uint64_t mNumDemuxStarvations;
 
     // These get overridden in the templated concrete class.
     // Indicate if we have a pending promise for decoded frame.
@@ -528,6 +547,8 @@ private:
       mSeekRequest.DisconnectIfExists();
       mTrackDemuxer->Reset();
       mQueuedSamples.Clear();
+      mDemuxIsPrefetch = false;
+      mDeferredDemuxFailure.reset();
     }
 
     // Flush the decoder if present and reset decoding related data.
@@ -556,6 +577,7 @@ private:
       mDemuxEOS = false;
       mWaitingForData = false;
       mQueuedSamples.Clear();
+      mDeferredDemuxFailure.reset();
       mDecodeRequest.DisconnectIfExists();
       mDrainRequest.DisconnectIfExists();
       mDrainState = DrainState::None;
@@ -711,6 +733,7 @@ private:
   MozPromiseRequestHolder<NotifyDataArrivedPromise> mNotifyDataArrivedPromise;
   bool mPendingNotifyDataArrived;
   void OnDemuxFailed(TrackType aTrack, const MediaResult &aError);
+  void HandleDemuxFailure(TrackType aTrack, const MediaResult& aError);
 
   void DoDemuxVideo();
   void OnVideoDemuxCompleted(RefPtr<MediaTrackDemuxer::SamplesHolder> aSamples);
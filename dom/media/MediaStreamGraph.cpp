@@ -1209,6 +1209,15 @@ MediaStreamGraphImpl::ProduceDataForStreamsBlockByBlock(uint32_t aStreamIndex,
   MOZ_ASSERT(OnGraphThread());
   MOZ_ASSERT(aStreamIndex <= mFirstCycleBreaker,
              "Cycle breaker is not AudioNodeStream?");
+  // Collect the streams to process once instead of re-checking every stream
+  // for every block.  mBlockByBlockStreams retains its storage between
+  // iterations, so this does not allocate on the graph thread once warmed up.
+  mBlockByBlockStreams.ClearAndRetainStorage();
+  for (uint32_t i = aStreamIndex; i < mStreams.Length(); ++i) {
+    if (ProcessedMediaStream* ps = mStreams[i]->AsProcessedStream()) {
+      mBlockByBlockStreams.AppendElement(ps);
+    }
+  }
   GraphTime t = mProcessedTime;
   while (t < mStateComputedTime) {
     GraphTime next = RoundUpToNextAudioBlock(t);
@@ -1217,12 +1226,10 @@ MediaStreamGraphImpl::ProduceDataForStreamsBlockByBlock(uint32_t aStreamIndex,
       MOZ_ASSERT(ns->AsAudioNodeStream());
       ns->ProduceOutputBeforeInput(t);
     }
-    for (uint32_t i = aStreamIndex; i < mStreams.Length(); ++i) {
-      ProcessedMediaStream* ps = mStreams[i]->AsProcessedStream();
-      if (ps) {
-        ps->ProcessInput(t, next,
-            (next == mStateComputedTime) ? ProcessedMediaStream::ALLOW_FINISH : 0);
-      }
+    uint32_t flags =
+      (next == mStateComputedTime) ? ProcessedMediaStream::ALLOW_FINISH : 0;
+    for (ProcessedMediaStream* ps : mBlockByBlockStreams) {
+      ps->ProcessInput(t, next, flags);
     }
     t = next;
   }
@@ -671,6 +671,12 @@ public:
    * cycles.
    */
   uint32_t mFirstCycleBreaker;
+  /**
+   * Scratch list of the processed streams handled by
+   * ProduceDataForStreamsBlockByBlock, kept as a member so that its storage
+   * is reused from one iteration to the next.
+   */
+  nsTArray<ProcessedMediaStream*> mBlockByBlockStreams;
   /**
    * Blocking decisions have been computed up to this time.
    * Between each iteration, this is the same as mProcessedTime.
@@ -4,6 +4,7 @@
 
 #include "VideoUtils.h"
 
+#include <algorithm>
 #include <functional>
 #include <stdint.h>
 
@@ -28,6 +29,7 @@
 #include "nsMathUtils.h"
 #include "nsServiceManagerUtils.h"
 #include "nsThreadUtils.h"
+#include "prsystem.h"
 
 namespace mozilla {
 
@@ -222,6 +224,26 @@ IsValidVideoRegion(const gfx::IntSize& aFrame,
     aDisplay.width * aDisplay.height != 0;
 }
 
+int32_t
+TileThreadedDecoderThreadCount(const gfx::IntSize& aFrame)
+{
+  // Minimum tile width in VP9.
+  static const int32_t kMinTileWidth = 256;
+  // Tile column counts are powers of two, so round down to the largest
+  // number of tile columns the frame can be split into. This matches the
+  // previous 2/4/8 width steps below 4096 pixels, and keeps doubling beyond:
+  // a 4K frame can carry 16 tile columns, which 8 threads would decode two at
+  // a time.
+  int32_t maxTileColumns = std::max(aFrame.width / kMinTileWidth, 1);
+  int32_t threads = 1;
+  while (threads * 2 <= maxTileColumns) {
+    threads *= 2;
+  }
+  // Small frames still benefit from a second thread for loop filtering.
+  threads = std::max(threads, 2);
+  return std::max(std::min(threads, PR_GetNumberOfProcessors()), 1);
+}
+
 already_AddRefed<SharedThreadPool> GetMediaThreadPool(MediaThreadType aType)
 {
   const char *name;
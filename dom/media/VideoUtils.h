@@ -175,6 +175,14 @@ IsValidVideoRegion(const gfx::IntSize& aFrame,
                    const gfx::IntRect& aPicture,
                    const gfx::IntSize& aDisplay);
 
+// Returns the number of threads the libvpx VP9 decoder should be configured
+// with for frames of size aFrame. It only splits work across tile columns,
+// which are at least 256 pixels wide, so threads beyond the number of tile
+// columns stay idle. The result is also capped to the number of processors
+// and is never less than 1.
+int32_t
+TileThreadedDecoderThreadCount(const gfx::IntSize& aFrame);
+
 // Template to automatically set a variable to a value on scope exit.
 // Useful for unsetting flags, etc.
 template<typename T>
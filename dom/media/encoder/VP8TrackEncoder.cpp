@@ -34,6 +34,38 @@ using namespace mozilla::layers;
 using namespace mozilla::media;
 using namespace mozilla::dom;
 
+// Picks the number of libvpx encoder threads for a frame of aWidth x
+// aHeight, leaving headroom for capture and the rest of the recording
+// pipeline.
+static unsigned int
+NumberOfThreads(int32_t aWidth, int32_t aHeight, int32_t aNumberOfCores)
+{
+  if (aWidth * aHeight >= 1920 * 1080 && aNumberOfCores > 8) {
+    return 8; // 8 threads for 1080p on high performance machines.
+  } else if (aWidth * aHeight > 1280 * 960 && aNumberOfCores >= 6) {
+    return 3; // 3 threads for 1080p.
+  } else if (aWidth * aHeight > 640 * 480 && aNumberOfCores >= 3) {
+    return 2; // 2 threads for qHD/HD.
+  } else {
+    return 1; // 1 thread for VGA or less.
+  }
+}
+
+// Splits the residual tokens into one partition per encoder thread, so the
+// recording can be decoded on as many threads as it was encoded with.
+static vp8e_token_partitions
+TokenPartitionsForThreads(unsigned int aThreads)
+{
+  if (aThreads >= 8) {
+    return VP8_EIGHT_TOKENPARTITION;
+  } else if (aThreads >= 3) {
+    return VP8_FOUR_TOKENPARTITION;
+  } else if (aThreads == 2) {
+    return VP8_TWO_TOKENPARTITION;
+  }
+  return VP8_ONE_TOKENPARTITION;
+}
+
 VP8TrackEncoder::VP8TrackEncoder(TrackRate aTrackRate,
                                  FrameDroppingMode aFrameDroppingMode)
   : VideoTrackEncoder(aTrackRate, aFrameDroppingMode)
@@ -95,7 +127,7 @@ VP8TrackEncoder::Init(int32_t aWidth, int32_t aHeight, int32_t aDisplayWidth,
   vpx_codec_control(mVPXContext, VP8E_SET_STATIC_THRESHOLD, 1);
   vpx_codec_control(mVPXContext, VP8E_SET_CPUUSED, -6);
   vpx_codec_control(mVPXContext, VP8E_SET_TOKEN_PARTITIONS,
-                    VP8_ONE_TOKENPARTITION);
+                    TokenPartitionsForThreads(config.g_threads));
 
   SetInitialized();
 
@@ -128,6 +160,8 @@ VP8TrackEncoder::Reconfigure(int32_t aWidth, int32_t aHeight,
     VP8LOG(LogLevel::Error, "Failed to set new configuration");
     return NS_ERROR_FAILURE;
   }
+  vpx_codec_control(mVPXContext, VP8E_SET_TOKEN_PARTITIONS,
+                    TokenPartitionsForThreads(config.g_threads));
   return NS_OK;
 }
 
@@ -163,14 +197,8 @@ VP8TrackEncoder::SetConfigurationValues(int32_t aWidth, int32_t aHeight, int32_t
 
   config.g_lag_in_frames = 0; // 0- no frame lagging
 
-  int32_t number_of_cores = PR_GetNumberOfProcessors();
-  if (mFrameWidth * mFrameHeight > 1280 * 960 && number_of_cores >= 6) {
-    config.g_threads = 3; // 3 threads for 1080p.
-  } else if (mFrameWidth * mFrameHeight > 640 * 480 && number_of_cores >= 3) {
-    config.g_threads = 2; // 2 threads for qHD/HD.
-  } else {
-    config.g_threads = 1; // 1 thread for VGA or less
-  }
+  config.g_threads =
+    NumberOfThreads(mFrameWidth, mFrameHeight, PR_GetNumberOfProcessors());
 
   // rate control settings
   config.rc_dropframe_thresh = 0;
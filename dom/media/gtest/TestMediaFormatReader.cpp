@@ -0,0 +1,171 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "gtest/gtest.h"
+#include "MediaContainerType.h"
+#include "MediaFormatReader.h"
+#include "MockMediaResource.h"
+#include "WebMDecoder.h"
+#include "WebMDemuxer.h"
+#include "mozilla/AbstractThread.h"
+#include "mozilla/Preferences.h"
+#include "nsMimeTypes.h"
+#include "nsThreadUtils.h"
+
+using namespace mozilla;
+using media::TimeUnit;
+
+static const char* kSkipPref = "media.decoder.skip-to-next-key-frame.enabled";
+
+class MediaFormatReaderRunner
+{
+public:
+  explicit MediaFormatReaderRunner(MediaResource* aResource)
+  {
+    MediaFormatReaderInit init;
+    init.mResource = aResource;
+    mReader = new MediaFormatReader(init, new WebMDemuxer(aResource));
+  }
+
+  bool ReadMetadata()
+  {
+    bool done = false;
+    bool success = false;
+    if (NS_FAILED(mReader->Init())) {
+      return false;
+    }
+    RefPtr<MediaFormatReader> reader = mReader;
+    InvokeAsync(mReader->OwnerThread(), __func__,
+                [reader]() { return reader->AsyncReadMetadata(); })
+      ->Then(
+        // Non DocGroup-version of AbstractThread::MainThread() is fine for testing.
+        AbstractThread::MainThread(), __func__,
+        [&](MetadataHolder&& aMetadata) {
+          success = aMetadata.mInfo && aMetadata.mInfo->HasVideo();
+          done = true;
+        },
+        [&](const MediaResult& aError) { done = true; });
+    SpinEventLoopUntil([&]() { return done; });
+    return success;
+  }
+
+  // Returns the start time of the next decoded frame, or nothing once the
+  // stream has ended or failed.
+  Maybe<TimeUnit> RequestVideoData(const TimeUnit& aTimeThreshold)
+  {
+    bool done = false;
+    Maybe<TimeUnit> result;
+    RefPtr<MediaFormatReader> reader = mReader;
+    InvokeAsync(mReader->OwnerThread(), __func__,
+                [reader, aTimeThreshold]() {
+                  return reader->RequestVideoData(aTimeThreshold);
+                })
+      ->Then(AbstractThread::MainThread(), __func__,
+             [&](RefPtr<VideoData> aVideo) {
+               result = Some(aVideo->mTime);
+               done = true;
+             },
+             [&](const MediaResult& aError) {
+               EXPECT_EQ(aError.Code(), NS_ERROR_DOM_MEDIA_END_OF_STREAM);
+               done = true;
+             });
+    SpinEventLoopUntil([&]() { return done; });
+    return result;
+  }
+
+  void Shutdown()
+  {
+    bool done = false;
+    RefPtr<MediaFormatReader> reader = mReader;
+    InvokeAsync(mReader->OwnerThread(), __func__,
+                [reader]() { return reader->Shutdown(); })
+      ->Then(AbstractThread::MainThread(), __func__,
+             [&]() { done = true; },
+             [&]() { done = true; });
+    SpinEventLoopUntil([&]() { return done; });
+  }
+
+private:
+  RefPtr<MediaFormatReader> mReader;
+};
+
+// Returns the start times of the keyframes in the file's video track.
+static nsTArray<TimeUnit>
+GetVideoKeyframeTimes(MediaResource* aResource)
+{
+  nsTArray<TimeUnit> keyframes;
+  RefPtr<WebMDemuxer> demuxer = new WebMDemuxer(aResource);
+  bool done = false;
+  demuxer->Init()->Then(
+    AbstractThread::MainThread(), __func__,
+    [&]() {
+      RefPtr<MediaTrackDemuxer> track =
+        demuxer->GetTrackDemuxer(TrackInfo::kVideoTrack, 0);
+      track->GetSamples(INT32_MAX)->Then(
+        AbstractThread::MainThread(), __func__,
+        [&](RefPtr<MediaTrackDemuxer::SamplesHolder> aSamples) {
+          for (const RefPtr<MediaRawData>& sample : aSamples->mSamples) {
+            if (sample->mKeyframe) {
+              keyframes.AppendElement(sample->mTime);
+            }
+          }
+          done = true;
+        },
+        [&](const MediaResult& aError) { done = true; });
+    },
+    [&](const MediaResult& aError) { done = true; });
+  SpinEventLoopUntil([&]() { return done; });
+  return keyframes;
+}
+
+// While decoding, the reader demuxes the next sample ahead of the decoder.
+// Skipping to a keyframe afterwards must discard that sample and carry on from
+// the keyframe.
+TEST(MediaFormatReader, PrefetchThenSkipToNextKeyFrame)
+{
+  if (!WebMDecoder::IsSupportedType(
+         MediaContainerType(MEDIAMIMETYPE(VIDEO_WEBM)))) {
+    return;
+  }
+
+  RefPtr<MockMediaResource> resource = new MockMediaResource("vp9cake.webm");
+  ASSERT_TRUE(NS_SUCCEEDED(resource->Open()));
+
+  // Skip to the last keyframe, well past the frames decoded up front.
+  nsTArray<TimeUnit> keyframes = GetVideoKeyframeTimes(resource);
+  ASSERT_GE(keyframes.Length(), 2u);
+  const TimeUnit keyframe = keyframes.LastElement();
+
+  bool skipEnabled = Preferences::GetBool(kSkipPref, true);
+  Preferences::SetBool(kSkipPref, true);
+
+  MediaFormatReaderRunner runner(resource);
+  ASSERT_TRUE(runner.ReadMetadata());
+
+  Maybe<TimeUnit> last;
+  for (uint32_t i = 0; i < 5; i++) {
+    Maybe<TimeUnit> time = runner.RequestVideoData(TimeUnit::Zero());
+    ASSERT_TRUE(time.isSome());
+    if (last) {
+      EXPECT_GT(time.ref(), last.ref());
+    }
+    last = time;
+  }
+  ASSERT_LT(last.ref(), keyframe);
+
+  // The next request skips while the sample demuxed ahead of the decoder is
+  // still held. Without a skip it would return the frame after the last one.
+  Maybe<TimeUnit> time = runner.RequestVideoData(keyframe);
+  ASSERT_TRUE(time.isSome());
+  EXPECT_GE(time.ref(), keyframe);
+  last = time;
+  while ((time = runner.RequestVideoData(keyframe))) {
+    EXPECT_GT(time.ref(), last.ref());
+    last = time;
+  }
+
+  runner.Shutdown();
+  Preferences::SetBool(kSkipPref, skipEnabled);
+}
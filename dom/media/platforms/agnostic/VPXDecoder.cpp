@@ -10,6 +10,7 @@
 #include "mozilla/PodOperations.h"
 #include "mozilla/SyncRunnable.h"
 #include "ImageContainer.h"
+#include "VideoUtils.h"
 #include "nsError.h"
 #include "prsystem.h"
 
@@ -40,7 +41,7 @@ InitContext(vpx_codec_ctx_t* aCtx,
             const VideoInfo& aInfo,
             const VPXDecoder::Codec aCodec)
 {
-  int decode_threads = 2;
+  int decode_threads = std::min(2, PR_GetNumberOfProcessors());
 
   vpx_codec_iface_t* dx = nullptr;
   if (aCodec == VPXDecoder::Codec::VP8) {
@@ -48,14 +49,10 @@ InitContext(vpx_codec_ctx_t* aCtx,
   }
   else if (aCodec == VPXDecoder::Codec::VP9) {
     dx = vpx_codec_vp9_dx();
-    if (aInfo.mDisplay.width >= 2048) {
-      decode_threads = 8;
-    }
-    else if (aInfo.mDisplay.width >= 1024) {
-      decode_threads = 4;
-    }
+    decode_threads = TileThreadedDecoderThreadCount(
+      gfx::IntSize(std::max(aInfo.mImage.width, aInfo.mDisplay.width),
+                   std::max(aInfo.mImage.height, aInfo.mDisplay.height)));
   }
-  decode_threads = std::min(decode_threads, PR_GetNumberOfProcessors());
 
   vpx_codec_dec_cfg_t config;
   config.threads = decode_threads;
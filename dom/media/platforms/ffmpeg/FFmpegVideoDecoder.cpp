@@ -333,6 +333,13 @@ FFmpegVideoDecoder<LIBAV_VER>::DoDecode(MediaRawData* aSample,
         break;
     }
   }
+  // This is the only copy of the decoded planes on this path: when the
+  // container is backed by the ImageBridge, CreateAndCopyData writes straight
+  // into a recycled shared-memory YCbCr TextureClient (see
+  // SharedPlanarYCbCrImage::CopyData), which the compositor then uses as-is.
+  // Removing it would require decoding into those TextureClients through a
+  // custom AVCodecContext::get_buffer2, with buffers padded to
+  // avcodec_align_dimensions2() and released through AVBufferRef callbacks.
   RefPtr<VideoData> v =
     VideoData::CreateAndCopyData(mInfo,
                                   mImageContainer,
@@ -16,6 +16,9 @@
 #include "AlignmentUtils.h"
 #include "AudioNodeEngineSSE2.h"
 #endif
+#ifdef USE_AVX
+#include "AudioNodeEngineAVX.h"
+#endif
 #include "AudioBlock.h"
 
 namespace mozilla {
@@ -101,7 +104,15 @@ void AudioBufferAddWithScale(const float* aInput,
     // we need to round aSize down to the nearest multiple of 16
     uint32_t alignedSize = aSize & ~0x0F;
     if (alignedSize > 0) {
+#ifdef USE_AVX
+      if (mozilla::supports_avx()) {
+        AudioBufferAddWithScale_AVX(aInput, aScale, aOutput, alignedSize);
+      } else {
+        AudioBufferAddWithScale_SSE(aInput, aScale, aOutput, alignedSize);
+      }
+#else
       AudioBufferAddWithScale_SSE(aInput, aScale, aOutput, alignedSize);
+#endif
 
       // adjust parameters for use with scalar operations below
       aInput += alignedSize;
@@ -145,6 +156,13 @@ AudioBlockCopyChannelWithScale(const float* aInput,
     }
 #endif
 
+#ifdef USE_AVX
+    if (mozilla::supports_avx()) {
+      AudioBlockCopyChannelWithScale_AVX(aInput, aScale, aOutput);
+      return;
+    }
+#endif
+
 #ifdef USE_SSE2
     if (mozilla::supports_sse2()) {
       AudioBlockCopyChannelWithScale_SSE(aInput, aScale, aOutput);
@@ -165,6 +183,13 @@ BufferComplexMultiply(const float* aInput,
                       uint32_t aSize)
 {
 
+#ifdef USE_AVX
+  if (mozilla::supports_avx()) {
+    BufferComplexMultiply_AVX(aInput, aScale, aOutput, aSize);
+    return;
+  }
+#endif
+
 #ifdef USE_SSE2
   if (mozilla::supports_sse()) {
     BufferComplexMultiply_SSE(aInput, aScale, aOutput, aSize);
@@ -323,6 +348,15 @@ AudioBlockPanStereoToStereo(const float aInputL[WEBAUDIO_BLOCK_SIZE],
   }
 #endif
 
+#ifdef USE_AVX
+  if (mozilla::supports_avx()) {
+    AudioBlockPanStereoToStereo_AVX(aInputL, aInputR,
+                                    aGainL, aGainR, aIsOnTheLeft,
+                                    aOutputL, aOutputR);
+    return;
+  }
+#endif
+
 #ifdef USE_SSE2
   if (mozilla::supports_sse2()) {
     AudioBlockPanStereoToStereo_SSE(aInputL, aInputR,
@@ -0,0 +1,129 @@
+/* -*- mode: c++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* this source code form is subject to the terms of the mozilla public
+ * license, v. 2.0. if a copy of the mpl was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "AudioNodeEngineAVX.h"
+#include "AlignmentUtils.h"
+#include <immintrin.h>
+
+// Audio buffers are only guaranteed to be 16-byte aligned, so these kernels
+// use unaligned 256-bit loads and stores.  They deliberately don't use FMA:
+// keeping separate multiplies and adds gives results that are bit-identical
+// to the SSE and scalar paths, whichever one a given CPU ends up taking.
+
+namespace mozilla {
+void
+AudioBufferAddWithScale_AVX(const float* aInput,
+                            float aScale,
+                            float* aOutput,
+                            uint32_t aSize)
+{
+  __m256 vin0, vin1,
+         vout0, vout1,
+         vgain;
+
+  ASSERT_ALIGNED16(aInput);
+  ASSERT_ALIGNED16(aOutput);
+  ASSERT_MULTIPLE16(aSize);
+
+  vgain = _mm256_set1_ps(aScale);
+
+  for (unsigned i = 0; i < aSize; i+=16) {
+    vin0 = _mm256_mul_ps(_mm256_loadu_ps(&aInput[i]), vgain);
+    vin1 = _mm256_mul_ps(_mm256_loadu_ps(&aInput[i + 8]), vgain);
+
+    vout0 = _mm256_add_ps(_mm256_loadu_ps(&aOutput[i]), vin0);
+    vout1 = _mm256_add_ps(_mm256_loadu_ps(&aOutput[i + 8]), vin1);
+
+    _mm256_storeu_ps(&aOutput[i], vout0);
+    _mm256_storeu_ps(&aOutput[i + 8], vout1);
+  }
+}
+
+void
+AudioBlockCopyChannelWithScale_AVX(const float* aInput,
+                                   float aScale,
+                                   float* aOutput)
+{
+  ASSERT_ALIGNED16(aInput);
+  ASSERT_ALIGNED16(aOutput);
+
+  __m256 vgain = _mm256_set1_ps(aScale);
+
+  for (unsigned i = 0 ; i < WEBAUDIO_BLOCK_SIZE; i+=16) {
+    __m256 vout0 = _mm256_mul_ps(_mm256_loadu_ps(&aInput[i]), vgain);
+    __m256 vout1 = _mm256_mul_ps(_mm256_loadu_ps(&aInput[i + 8]), vgain);
+    _mm256_storeu_ps(&aOutput[i], vout0);
+    _mm256_storeu_ps(&aOutput[i + 8], vout1);
+  }
+}
+
+void
+AudioBlockPanStereoToStereo_AVX(const float aInputL[WEBAUDIO_BLOCK_SIZE],
+                                const float aInputR[WEBAUDIO_BLOCK_SIZE],
+                                float aGainL, float aGainR, bool aIsOnTheLeft,
+                                float aOutputL[WEBAUDIO_BLOCK_SIZE],
+                                float aOutputR[WEBAUDIO_BLOCK_SIZE])
+{
+  __m256 vinl, vinr, vgainl, vgainr;
+
+  ASSERT_ALIGNED16(aInputL);
+  ASSERT_ALIGNED16(aInputR);
+  ASSERT_ALIGNED16(aOutputL);
+  ASSERT_ALIGNED16(aOutputR);
+
+  vgainl = _mm256_set1_ps(aGainL);
+  vgainr = _mm256_set1_ps(aGainR);
+
+  if (aIsOnTheLeft) {
+    for (unsigned i = 0; i < WEBAUDIO_BLOCK_SIZE; i+=8) {
+      vinl = _mm256_loadu_ps(&aInputL[i]);
+      vinr = _mm256_loadu_ps(&aInputR[i]);
+
+      /* left channel : aOutputL  = aInputL + aInputR * gainL */
+      _mm256_storeu_ps(&aOutputL[i],
+                       _mm256_add_ps(_mm256_mul_ps(vinr, vgainl), vinl));
+      /* right channel : aOutputR = aInputR * gainR */
+      _mm256_storeu_ps(&aOutputR[i], _mm256_mul_ps(vinr, vgainr));
+    }
+  } else {
+    for (unsigned i = 0; i < WEBAUDIO_BLOCK_SIZE; i+=8) {
+      vinl = _mm256_loadu_ps(&aInputL[i]);
+      vinr = _mm256_loadu_ps(&aInputR[i]);
+
+      /* left channel : aInputL * gainL */
+      _mm256_storeu_ps(&aOutputL[i], _mm256_mul_ps(vinl, vgainl));
+      /* right channel: aOutputR = aInputR + aInputL * gainR */
+      _mm256_storeu_ps(&aOutputR[i],
+                       _mm256_add_ps(_mm256_mul_ps(vinl, vgainr), vinr));
+    }
+  }
+}
+
+void
+BufferComplexMultiply_AVX(const float* aInput,
+                          const float* aScale,
+                          float* aOutput,
+                          uint32_t aSize)
+{
+  ASSERT_ALIGNED16(aInput);
+  ASSERT_ALIGNED16(aScale);
+  ASSERT_ALIGNED16(aOutput);
+  ASSERT_MULTIPLE16(aSize);
+
+  // Data is interleaved as (real, imag) pairs.  With a = ar + i*ai and
+  // b = br + i*bi, a*b = (ar*br - ai*bi) + i*(ai*br + ar*bi), which is
+  // addsub(a * [br, br], swap(a) * [bi, bi]) for each pair.
+  for (unsigned i = 0; i < aSize * 2; i += 8) {
+    __m256 a = _mm256_loadu_ps(&aInput[i]);
+    __m256 b = _mm256_loadu_ps(&aScale[i]);
+    __m256 breal = _mm256_moveldup_ps(b);
+    __m256 bimag = _mm256_movehdup_ps(b);
+    __m256 aswapped = _mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1));
+    _mm256_storeu_ps(&aOutput[i],
+                     _mm256_addsub_ps(_mm256_mul_ps(a, breal),
+                                      _mm256_mul_ps(aswapped, bimag)));
+  }
+}
+}
@@ -0,0 +1,32 @@
+/* -*- mode: c++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* this source code form is subject to the terms of the mozilla public
+ * license, v. 2.0. if a copy of the mpl was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "AudioNodeEngine.h"
+
+namespace mozilla {
+void
+AudioBufferAddWithScale_AVX(const float* aInput,
+                            float aScale,
+                            float* aOutput,
+                            uint32_t aSize);
+
+void
+AudioBlockCopyChannelWithScale_AVX(const float* aInput,
+                                   float aScale,
+                                   float* aOutput);
+
+void
+AudioBlockPanStereoToStereo_AVX(const float aInputL[WEBAUDIO_BLOCK_SIZE],
+                                const float aInputR[WEBAUDIO_BLOCK_SIZE],
+                                float aGainL, float aGainR, bool aIsOnTheLeft,
+                                float aOutputL[WEBAUDIO_BLOCK_SIZE],
+                                float aOutputR[WEBAUDIO_BLOCK_SIZE]);
+
+void
+BufferComplexMultiply_AVX(const float* aInput,
+                          const float* aScale,
+                          float* aOutput,
+                          uint32_t aSize);
+}
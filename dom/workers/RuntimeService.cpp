@@ -71,6 +71,7 @@
 #include "xpcpublic.h"
 
 #include "Principal.h"
+#include "ScriptLoader.h"
 #include "SharedWorker.h"
 #include "WorkerDebuggerManager.h"
 #include "WorkerError.h"
@@ -2082,6 +2083,8 @@ RuntimeService::Cleanup()
 
   NS_ASSERTION(!mWindowMap.Count(), "All windows should have been released!");
 
+  ClearCachedScripts();
+
   if (mObserved) {
     if (NS_FAILED(Preferences::UnregisterPrefixCallback(LoadContextOptions,
                                                         PREF_JS_OPTIONS_PREFIX)) ||
@@ -2650,6 +2653,7 @@ RuntimeService::Observe(nsISupports* aSubject, const char* aTopic,
     GarbageCollectAllWorkers(/* shrinking = */ true);
     CycleCollectAllWorkers();
     MemoryPressureAllWorkers();
+    ClearCachedScripts();
     return NS_OK;
   }
   if (!strcmp(aTopic, NS_IOSERVICE_OFFLINE_STATUS_TOPIC)) {
@@ -27,6 +27,7 @@
 #include "jsfriendapi.h"
 #include "js/CompilationAndEvaluation.h"
 #include "js/SourceBufferHolder.h"
+#include "js/Transcoding.h"
 #include "nsError.h"
 #include "nsContentPolicyUtils.h"
 #include "nsContentUtils.h"
@@ -44,6 +45,7 @@
 #include "xpcpublic.h"
 
 #include "mozilla/Assertions.h"
+#include "mozilla/HashFunctions.h"
 #include "mozilla/LoadContext.h"
 #include "mozilla/Maybe.h"
 #include "mozilla/ipc/BackgroundUtils.h"
@@ -67,6 +69,8 @@
 #include "mozilla/dom/ScriptSettings.h"
 #include "mozilla/dom/SRILogHelper.h"
 #include "mozilla/dom/ServiceWorkerBinding.h"
+#include "mozilla/StaticMutex.h"
+#include "mozilla/StaticPtr.h"
 #include "mozilla/UniquePtr.h"
 #include "Principal.h"
 #include "WorkerHolder.h"
@@ -353,6 +357,251 @@ struct ScriptLoadInfo
   }
 };
 
+// Pages frequently start several workers from the same script, and every one
+// of them would otherwise parse and compile it again in its own runtime. Once
+// the same script has been loaded twice we keep its XDR encoding around so
+// later workers can decode it instead. The URL and the muted errors flag are
+// baked into the encoded ScriptSource so they are part of the key, and the
+// source text has to match exactly for an entry to be used.
+#define MAX_CACHED_SCRIPTS 16
+#define MAX_CACHED_SCRIPTS_BYTES (4 * 1024 * 1024)
+#define MAX_CACHED_SCRIPT_SOURCE_BYTES (MAX_CACHED_SCRIPTS_BYTES / 8)
+#define MAX_SEEN_SCRIPTS 64
+
+class CachedScript final
+{
+public:
+  NS_INLINE_DECL_THREADSAFE_REFCOUNTING(CachedScript)
+
+  CachedScript(const nsAString& aURL, bool aMutedErrors, uint32_t aSourceHash,
+               nsString&& aSource, JS::TranscodeBuffer&& aBytecode)
+    : mURL(aURL)
+    , mSource(std::move(aSource))
+    , mBytecode(std::move(aBytecode))
+    , mSourceHash(aSourceHash)
+    , mMutedErrors(aMutedErrors)
+  { }
+
+  bool
+  Matches(const nsAString& aURL, bool aMutedErrors, uint32_t aSourceHash,
+          const char16_t* aSource, size_t aSourceLength) const
+  {
+    return mSourceHash == aSourceHash &&
+           mMutedErrors == aMutedErrors &&
+           mSource.Length() == aSourceLength &&
+           mURL.Equals(aURL) &&
+           !memcmp(mSource.BeginReading(), aSource,
+                   aSourceLength * sizeof(char16_t));
+  }
+
+  bool
+  Matches(const CachedScript& aOther) const
+  {
+    return Matches(aOther.mURL, aOther.mMutedErrors, aOther.mSourceHash,
+                   aOther.mSource.BeginReading(), aOther.mSource.Length());
+  }
+
+  size_t
+  SizeInBytes() const
+  {
+    return mSource.Length() * sizeof(char16_t) + mBytecode.length();
+  }
+
+  JS::TranscodeRange
+  Bytecode()
+  {
+    return JS::TranscodeRange(mBytecode.begin(), mBytecode.length());
+  }
+
+private:
+  ~CachedScript()
+  { }
+
+  const nsString mURL;
+  const nsString mSource;
+  JS::TranscodeBuffer mBytecode;
+  const uint32_t mSourceHash;
+  const bool mMutedErrors;
+};
+
+// Scripts that missed the cache once. Only a second miss pays for a copy of
+// the source and an encoding, so scripts that are loaded by a single worker
+// cost nothing extra.
+struct SeenScript
+{
+  nsString mURL;
+  uint32_t mSourceHash;
+  bool mMutedErrors;
+};
+
+// Most recently used entries are at the end. Touched from any worker thread,
+// so always under sCachedScriptsMutex.
+StaticMutex sCachedScriptsMutex;
+StaticAutoPtr<nsTArray<RefPtr<CachedScript>>> sCachedScripts;
+StaticAutoPtr<nsTArray<SeenScript>> sSeenScripts;
+
+already_AddRefed<CachedScript>
+LookupCachedScript(const nsAString& aURL, bool aMutedErrors,
+                   uint32_t aSourceHash, const char16_t* aSource,
+                   size_t aSourceLength)
+{
+  StaticMutexAutoLock lock(sCachedScriptsMutex);
+  if (!sCachedScripts) {
+    return nullptr;
+  }
+
+  for (size_t index = sCachedScripts->Length(); index > 0; index--) {
+    RefPtr<CachedScript>& entry = sCachedScripts->ElementAt(index - 1);
+    if (entry->Matches(aURL, aMutedErrors, aSourceHash, aSource,
+                       aSourceLength)) {
+      RefPtr<CachedScript> found = entry;
+      sCachedScripts->RemoveElementAt(index - 1);
+      sCachedScripts->AppendElement(found);
+      return found.forget();
+    }
+  }
+
+  return nullptr;
+}
+
+// Returns true if this script already missed the cache before. Otherwise
+// remembers it and returns false.
+bool
+NoteCacheMiss(const nsAString& aURL, bool aMutedErrors, uint32_t aSourceHash)
+{
+  StaticMutexAutoLock lock(sCachedScriptsMutex);
+  if (!sSeenScripts) {
+    sSeenScripts = new nsTArray<SeenScript>();
+  }
+
+  for (size_t index = 0; index < sSeenScripts->Length(); index++) {
+    const SeenScript& seen = sSeenScripts->ElementAt(index);
+    if (seen.mSourceHash == aSourceHash &&
+        seen.mMutedErrors == aMutedErrors &&
+        seen.mURL.Equals(aURL)) {
+      sSeenScripts->RemoveElementAt(index);
+      return true;
+    }
+  }
+
+  if (sSeenScripts->Length() >= MAX_SEEN_SCRIPTS) {
+    sSeenScripts->RemoveElementAt(0);
+  }
+  SeenScript* seen = sSeenScripts->AppendElement();
+  seen->mURL = aURL;
+  seen->mSourceHash = aSourceHash;
+  seen->mMutedErrors = aMutedErrors;
+  return false;
+}
+
+void
+StoreCachedScript(already_AddRefed<CachedScript> aEntry)
+{
+  RefPtr<CachedScript> entry = aEntry;
+  if (entry->SizeInBytes() > MAX_CACHED_SCRIPTS_BYTES / 4) {
+    return;
+  }
+
+  StaticMutexAutoLock lock(sCachedScriptsMutex);
+  if (!sCachedScripts) {
+    sCachedScripts = new nsTArray<RefPtr<CachedScript>>();
+  }
+
+  // Another worker may have stored the same script in the meantime.
+  size_t totalBytes = entry->SizeInBytes();
+  for (size_t index = sCachedScripts->Length(); index > 0; index--) {
+    const RefPtr<CachedScript>& cached = sCachedScripts->ElementAt(index - 1);
+    if (cached->Matches(*entry)) {
+      sCachedScripts->RemoveElementAt(index - 1);
+    } else {
+      totalBytes += cached->SizeInBytes();
+    }
+  }
+
+  // Evict from the least recently used end until the new entry fits.
+  size_t evictCount = 0;
+  while (evictCount < sCachedScripts->Length() &&
+         (sCachedScripts->Length() - evictCount >= MAX_CACHED_SCRIPTS ||
+          totalBytes > MAX_CACHED_SCRIPTS_BYTES)) {
+    totalBytes -= sCachedScripts->ElementAt(evictCount)->SizeInBytes();
+    evictCount++;
+  }
+  sCachedScripts->RemoveElementsAt(0, evictCount);
+
+  sCachedScripts->AppendElement(std::move(entry));
+}
+
+// Compiles the script, stores its encoding in the cache and runs it.
+bool
+CompileAndCacheScript(JSContext* aCx, const JS::CompileOptions& aOptions,
+                      const nsAString& aURL, bool aMutedErrors,
+                      uint32_t aSourceHash, JS::SourceBufferHolder& aSrcBuf)
+{
+  // The compiler may take ownership of the buffer, so copy the text we key on
+  // up front.
+  nsString source(aSrcBuf.get(), aSrcBuf.length());
+
+  JS::Rooted<JSScript*> script(aCx);
+  if (!JS::Compile(aCx, aOptions, aSrcBuf, &script)) {
+    return false;
+  }
+
+  // Encode before the script runs; top-level scripts cannot be encoded once
+  // they have executed. Failing to encode only costs us the cache entry.
+  JS::TranscodeBuffer bytecode;
+  if (JS::EncodeScript(aCx, bytecode, script) == JS::TranscodeResult_Ok) {
+    StoreCachedScript(
+      MakeAndAddRef<CachedScript>(aURL, aMutedErrors, aSourceHash,
+                                  std::move(source), std::move(bytecode)));
+  } else {
+    JS_ClearPendingException(aCx);
+  }
+
+  return JS_ExecuteScript(aCx, script);
+}
+
+// Runs the script in aSrcBuf, going through the shared cache when another
+// worker of this process has loaded the same script before. Everything else is
+// evaluated directly, which keeps the run-once optimizations for it.
+bool
+EvaluateScript(JSContext* aCx, WorkerPrivate* aWorkerPrivate,
+               JS::CompileOptions& aOptions, const nsAString& aURL,
+               bool aMutedErrors, JS::SourceBufferHolder& aSrcBuf)
+{
+  // The cache outlives any single worker, so private browsing workers must
+  // neither add to it nor read from it.
+  if (aWorkerPrivate->GetOriginAttributes().mPrivateBrowsingId == 0 &&
+      aSrcBuf.length() * sizeof(char16_t) <= MAX_CACHED_SCRIPT_SOURCE_BYTES) {
+    uint32_t hash = HashString(aSrcBuf.get(), aSrcBuf.length());
+    RefPtr<CachedScript> cached =
+      LookupCachedScript(aURL, aMutedErrors, hash, aSrcBuf.get(),
+                         aSrcBuf.length());
+    if (cached) {
+      JS::Rooted<JSScript*> script(aCx);
+      JS::TranscodeResult tr =
+        JS::DecodeScript(aCx, cached->Bytecode(), &script);
+      if (tr == JS::TranscodeResult_Ok) {
+        return JS_ExecuteScript(aCx, script);
+      }
+      if (tr == JS::TranscodeResult_Throw) {
+        return false;
+      }
+      // Any other failure just means we have to compile from source after
+      // all, and replace the entry while we are at it.
+      return CompileAndCacheScript(aCx, aOptions, aURL, aMutedErrors, hash,
+                                   aSrcBuf);
+    }
+
+    if (NoteCacheMiss(aURL, aMutedErrors, hash)) {
+      return CompileAndCacheScript(aCx, aOptions, aURL, aMutedErrors, hash,
+                                   aSrcBuf);
+    }
+  }
+
+  JS::Rooted<JS::Value> unused(aCx);
+  return JS::Evaluate(aCx, aOptions, aSrcBuf, &unused);
+}
+
 class ScriptLoaderRunnable;
 
 class ScriptExecutorRunnable final : public MainThreadWorkerSyncRunnable
@@ -2089,8 +2338,8 @@ ScriptExecutorRunnable::WorkerRun(JSContext* aCx, WorkerPrivate* aWorkerPrivate)
 
     // Our ErrorResult still shouldn't be a failure.
     MOZ_ASSERT(!mScriptLoader.mRv.Failed(), "Who failed it and why?");
-    JS::Rooted<JS::Value> unused(aCx);
-    if (!JS::Evaluate(aCx, options, srcBuf, &unused)) {
+    if (!EvaluateScript(aCx, aWorkerPrivate, options, loadInfo.mURL,
+                        loadInfo.mMutedErrorFlag.valueOr(true), srcBuf)) {
       mScriptLoader.mRv.StealExceptionFromJSContext(aCx);
       return true;
     }
@@ -2413,6 +2662,14 @@ Load(WorkerPrivate* aWorkerPrivate,
   LoadAllScripts(aWorkerPrivate, loadInfos, false, aWorkerScriptType, aRv);
 }
 
+void
+ClearCachedScripts()
+{
+  StaticMutexAutoLock lock(sCachedScriptsMutex);
+  sCachedScripts = nullptr;
+  sSeenScripts = nullptr;
+}
+
 } // namespace workerinternals
 
 } // dom namespace
@@ -63,6 +63,9 @@ void Load(WorkerPrivate* aWorkerPrivate,
           WorkerScriptType aWorkerScriptType,
           ErrorResult& aRv);
 
+// Drops the compiled scripts shared between workers of this process.
+void ClearCachedScripts();
+
 } // namespace workerinternals
 
 } // dom namespace
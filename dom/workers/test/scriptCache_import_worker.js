@@ -0,0 +1,16 @@
+/**
+ * Any copyright is dedicated to the Public Domain.
+ * http://creativecommons.org/publicdomain/zero/1.0/
+ */
+// Imports the script at the given URL and reports the message of the error
+// thrown by a function it defines, which is "Script error." if the imported
+// script had its errors muted.
+addEventListener("error", function(event) {
+  event.preventDefault();
+  postMessage(event.message);
+});
+
+onmessage = function(event) {
+  importScripts(event.data);
+  setTimeout(throwFromImport, 0);
+};
@@ -22,6 +22,10 @@
 #include "nsDisplayList.h"
 #include "WebRenderCanvasRenderer.h"
 
+#ifdef MOZ_GECKO_PROFILER
+#include "ProfilerMarkerPayload.h"
+#endif
+
 #ifdef XP_WIN
 #include "gfxDWriteFonts.h"
 #endif
@@ -214,6 +218,17 @@ WebRenderLayerManager::EndEmptyTransaction(EndTransactionFlags aFlags)
   // Since we don't do repeat transactions right now, just set the time
   mAnimationReadyTime = TimeStamp::Now();
 
+  // The compositor keeps using the WebRender display list from the last full
+  // transaction, so we don't pay for translating our display list again.
+#ifdef MOZ_GECKO_PROFILER
+  if (profiler_is_active()) {
+    profiler_add_marker(
+      "WebRenderDisplayListReused",
+      MakeUnique<WebRenderDisplayListReusedMarkerPayload>(
+        mLastDisplayListBuildTime, mAnimationReadyTime));
+  }
+#endif
+
   if (aFlags & EndTransactionFlags::END_NO_COMPOSITE && 
       !mWebRenderCommandBuilder.NeedsEmptyTransaction() &&
       mPendingScrollUpdates.empty()) {
@@ -288,6 +303,7 @@ WebRenderLayerManager::EndTransactionWithoutLayer(nsDisplayList* aDisplayList,
     // Record the time spent "layerizing". WR doesn't actually layerize but
     // generating the WR display list is the closest equivalent
     PaintTelemetry::AutoRecord record(PaintTelemetry::Metric::Layerization);
+    TimeStamp buildStart = TimeStamp::Now();
 
     mWebRenderCommandBuilder.BuildWebRenderCommands(builder,
                                                     resourceUpdates,
@@ -296,6 +312,7 @@ WebRenderLayerManager::EndTransactionWithoutLayer(nsDisplayList* aDisplayList,
                                                     mScrollData,
                                                     contentSize,
                                                     aFilters);
+    mLastDisplayListBuildTime = TimeStamp::Now() - buildStart;
     builderDumpIndex = mWebRenderCommandBuilder.GetBuilderDumpIndex();
     containsSVGGroup = mWebRenderCommandBuilder.GetContainsSVGGroup();
   } else {
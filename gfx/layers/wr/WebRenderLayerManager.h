@@ -219,6 +219,10 @@ private:
   WebRenderCommandBuilder mWebRenderCommandBuilder;
 
   size_t mLastDisplayListSize;
+  // How long it took to translate the display list into the WebRender display
+  // list that is currently retained on the compositor side. An empty
+  // transaction reuses that list, so this is the build time it saves.
+  TimeDuration mLastDisplayListBuildTime;
 };
 
 } // namespace layers
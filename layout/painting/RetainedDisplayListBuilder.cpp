@@ -8,6 +8,7 @@
 #include "RetainedDisplayListBuilder.h"
 
 #include "DisplayListChecker.h"
+#include "GeckoProfiler.h"
 #include "gfxPrefs.h"
 #include "nsPlaceholderFrame.h"
 #include "nsSubDocumentFrame.h"
@@ -235,6 +236,34 @@ AnyContentAncestorModified(nsIFrame* aFrame, nsIFrame* aStopAtFrame = nullptr)
   return false;
 }
 
+bool
+RetainedDisplayListBuilder::AnyContentAncestorModifiedCached(nsIFrame* aFrame)
+{
+  // Walk up until we either find a modified frame or a frame whose answer we
+  // already know, then record the answer for every frame we passed through.
+  AutoTArray<nsIFrame*, 32> visited;
+  bool modified = false;
+  for (nsIFrame* f = aFrame; f;
+       f = nsLayoutUtils::GetParentOrPlaceholderForCrossDoc(f)) {
+    bool cached;
+    if (mModifiedAncestorCache.Get(f, &cached)) {
+      modified = cached;
+      break;
+    }
+
+    visited.AppendElement(f);
+    if (f->IsFrameModified()) {
+      modified = true;
+      break;
+    }
+  }
+
+  for (nsIFrame* f : visited) {
+    mModifiedAncestorCache.Put(f, modified);
+  }
+  return modified;
+}
+
 static void
 UpdateASR(nsDisplayItem* aItem, Maybe<const ActiveScrolledRoot*>& aContainerASR)
 {
@@ -456,7 +485,8 @@ public:
 
   bool HasModifiedFrame(nsDisplayItem* aItem)
   {
-    return AnyContentAncestorModified(aItem->FrameForInvalidation());
+    return mBuilder->AnyContentAncestorModifiedCached(
+      aItem->FrameForInvalidation());
   }
 
   void UpdateContainerASR(nsDisplayItem* aItem)
@@ -1408,9 +1438,16 @@ RetainedDisplayListBuilder::AttemptPartialUpdate(
   // we call RestoreState on nsDisplayWrapList it resets the clip to the base
   // clip, and we need the UpdateBounds call (within MergeDisplayLists) to
   // move it to the correct inner clip.
-  Maybe<const ActiveScrolledRoot*> dummy;
-  if (MergeDisplayLists(&modifiedDL, &mList, &mList, dummy)) {
-    result = PartialUpdateResult::Updated;
+  {
+    AUTO_PROFILER_TRACING("Paint", "DisplayListMerge");
+    PaintTelemetry::AutoRecord record(
+      PaintTelemetry::Metric::DisplayListMerge);
+
+    Maybe<const ActiveScrolledRoot*> dummy;
+    if (MergeDisplayLists(&modifiedDL, &mList, &mList, dummy)) {
+      result = PartialUpdateResult::Updated;
+    }
+    mModifiedAncestorCache.Clear();
   }
 
   // printf_stderr("Painting --- Merged list:\n");
@@ -142,11 +142,22 @@ private:
 
   void IncrementSubDocPresShellPaintCount(nsDisplayItem* aItem);
 
+  /**
+   * Returns true if |aFrame| or any of its ancestors (crossing documents) is
+   * marked as modified. Results are memoized in mModifiedAncestorCache, which
+   * is only valid for the duration of a single merge.
+   */
+  bool AnyContentAncestorModifiedCached(nsIFrame* aFrame);
+
   friend class MergeState;
 
   nsDisplayListBuilder mBuilder;
   RetainedDisplayList mList;
   WeakFrame mPreviousCaret;
+
+  // Frame modified state doesn't change while merging, so every ancestor
+  // chain only has to be walked once instead of once per display item.
+  nsDataHashtable<nsPtrHashKey<nsIFrame>, bool> mModifiedAncestorCache;
 };
 
 #endif // RETAINEDDISPLAYLISTBUILDER_H_
@@ -58,6 +58,7 @@
 #include "StickyScrollContainer.h"
 #include "mozilla/AnimationPerformanceWarning.h"
 #include "mozilla/AnimationUtils.h"
+#include "mozilla/Atomics.h"
 #include "mozilla/AutoRestore.h"
 #include "mozilla/EffectCompositor.h"
 #include "mozilla/EffectSet.h"
@@ -1584,9 +1585,13 @@ nsDisplayListBuilder::MarkPreserve3DFramesForDisplayList(nsIFrame* aDirtyFrame)
   }
 }
 
-uint32_t gDisplayItemSizes[static_cast<uint32_t>(DisplayItemType::TYPE_MAX)] = {
-  0
-};
+// Maps each display item type to the arena size class its allocations use.
+// The table is shared by every nsDisplayListBuilder, so entries are atomics
+// that are only ever stored once; steady-state allocations just load them.
+// This keeps builders that live on different threads (e.g. building display
+// list subtrees into their own arenas) from racing on the table.
+static Atomic<uint32_t, Relaxed>
+  gDisplayItemSizes[static_cast<uint32_t>(DisplayItemType::TYPE_MAX)];
 
 void*
 nsDisplayListBuilder::Allocate(size_t aSize, DisplayItemType aType)
@@ -1594,9 +1599,14 @@ nsDisplayListBuilder::Allocate(size_t aSize, DisplayItemType aType)
   size_t roundedUpSize = RoundUpPow2(aSize);
   uint_fast8_t type = FloorLog2Size(roundedUpSize);
 
-  MOZ_RELEASE_ASSERT(gDisplayItemSizes[static_cast<uint32_t>(aType)] == type ||
-                     gDisplayItemSizes[static_cast<uint32_t>(aType)] == 0);
-  gDisplayItemSizes[static_cast<uint32_t>(aType)] = type;
+  Atomic<uint32_t, Relaxed>& cachedType =
+    gDisplayItemSizes[static_cast<uint32_t>(aType)];
+  if (MOZ_UNLIKELY(cachedType != type)) {
+    // First allocation of this item type. compareExchange fails only if
+    // another builder recorded a size class first, which must then match.
+    MOZ_RELEASE_ASSERT(cachedType.compareExchange(0, type) ||
+                       cachedType == type);
+  }
   return mPool.AllocateByCustomID(type, roundedUpSize);
 }
 
@@ -10533,6 +10543,7 @@ PaintTelemetry::AutoRecordPaint::~AutoRecordPaint()
   };
 
   double dlMs = sMetrics[Metric::DisplayList];
+  double dlmMs = sMetrics[Metric::DisplayListMerge];
   double flbMs = sMetrics[Metric::Layerization];
   double frMs = sMetrics[Metric::FlushRasterization];
   double rMs = sMetrics[Metric::Rasterization];
@@ -10541,11 +10552,13 @@ PaintTelemetry::AutoRecordPaint::~AutoRecordPaint()
   // painting. We bucket these metrics separately.
   if (totalMs >= 16.0) {
     recordLarge(NS_LITERAL_CSTRING("dl"), dlMs);
+    recordLarge(NS_LITERAL_CSTRING("dlm"), dlmMs);
     recordLarge(NS_LITERAL_CSTRING("flb"), flbMs);
     recordLarge(NS_LITERAL_CSTRING("fr"), frMs);
     recordLarge(NS_LITERAL_CSTRING("r"), rMs);
   } else {
     recordSmall(NS_LITERAL_CSTRING("dl"), dlMs);
+    recordSmall(NS_LITERAL_CSTRING("dlm"), dlmMs);
     recordSmall(NS_LITERAL_CSTRING("flb"), flbMs);
     recordSmall(NS_LITERAL_CSTRING("fr"), frMs);
     recordSmall(NS_LITERAL_CSTRING("r"), rMs);
@@ -10557,8 +10570,9 @@ PaintTelemetry::AutoRecordPaint::~AutoRecordPaint()
 PaintTelemetry::AutoRecord::AutoRecord(Metric aMetric)
   : mMetric(aMetric)
 {
-  // Don't double-record anything nested.
-  if (sMetricLevel++ > 0) {
+  // Don't double-record anything nested. Sub-phases don't count towards the
+  // nesting level, since their time is reported separately.
+  if (!IsSubPhase(aMetric) && sMetricLevel++ > 0) {
     return;
   }
 
@@ -10572,9 +10586,10 @@ PaintTelemetry::AutoRecord::AutoRecord(Metric aMetric)
 
 PaintTelemetry::AutoRecord::~AutoRecord()
 {
-  MOZ_ASSERT(sMetricLevel != 0);
-
-  sMetricLevel--;
+  if (!IsSubPhase(mMetric)) {
+    MOZ_ASSERT(sMetricLevel != 0);
+    sMetricLevel--;
+  }
   if (mStart.IsNull()) {
     return;
   }
@@ -7733,6 +7733,9 @@ public:
   enum class Metric
   {
     DisplayList,
+    // Merging a partial display list into the retained one. This is a
+    // sub-phase of DisplayList and is recorded even though it is nested.
+    DisplayListMerge,
     Layerization,
     FlushRasterization,
     Rasterization,
@@ -7763,6 +7766,11 @@ public:
   };
 
 private:
+  static bool IsSubPhase(Metric aMetric)
+  {
+    return aMetric == Metric::DisplayListMerge;
+  }
+
   static uint32_t sPaintLevel;
   static uint32_t sMetricLevel;
   static mozilla::EnumeratedArray<Metric, Metric::COUNT, double> sMetrics;
@@ -364,6 +364,11 @@ static int resampler_basic_direct_single(SpeexResamplerState *st, spx_uint32_t c
       sum = SATURATE32PSHR(sum, 15, 32767);
 #ifdef OVERRIDE_INNER_PRODUCT_SINGLE
       } else {
+#ifdef OVERRIDE_INNER_PRODUCT_SINGLE_AVX
+      if (moz_speex_have_avx())
+         sum = inner_product_single_avx(sinct, iptr, N);
+      else
+#endif
       sum = inner_product_single(sinct, iptr, N);
       }
 #endif
@@ -484,6 +489,11 @@ static int resampler_basic_interpolate_single(SpeexResamplerState *st, spx_uint3
 #ifdef OVERRIDE_INTERPOLATE_PRODUCT_SINGLE
       } else {
       cubic_coef(frac, interp);
+#ifdef OVERRIDE_INTERPOLATE_PRODUCT_SINGLE_AVX
+      if (moz_speex_have_avx())
+         sum = interpolate_product_single_avx(iptr, st->sinc_table + st->oversample + 4 - offset - 2, N, st->oversample, interp);
+      else
+#endif
       sum = interpolate_product_single(iptr, st->sinc_table + st->oversample + 4 - offset - 2, N, st->oversample, interp);
       }
 #endif
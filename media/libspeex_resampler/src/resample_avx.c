@@ -0,0 +1,57 @@
+/* vim: set shiftwidth=2 tabstop=8 autoindent cindent expandtab: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/* AVX versions of the single precision resampler inner loops. The filter
+ * length is always a multiple of 8, see update_filter(). */
+
+#include "simd_detect.h"
+
+#include <immintrin.h>
+
+static float hsum_ps_avx(__m256 v)
+{
+  float ret;
+  __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v),
+                          _mm256_extractf128_ps(v, 1));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 0x55));
+  _mm_store_ss(&ret, sum);
+  return ret;
+}
+
+float inner_product_single_avx(const float *a, const float *b, unsigned int len)
+{
+  unsigned int i;
+  __m256 sum = _mm256_setzero_ps();
+  for (i=0;i<len;i+=8)
+  {
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(a+i), _mm256_loadu_ps(b+i)));
+  }
+  return hsum_ps_avx(sum);
+}
+
+float interpolate_product_single_avx(const float *a, const float *b, unsigned int len, const spx_uint32_t oversample, float *frac)
+{
+  unsigned int i;
+  float ret;
+  __m128 f = _mm_loadu_ps(frac);
+  __m128 sum4;
+  __m256 sum = _mm256_setzero_ps();
+  /* Each iteration handles two taps, one per 128-bit lane. */
+  for (i=0;i<len;i+=2)
+  {
+    __m256 coef = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(b+i*oversample)),
+                                       _mm_loadu_ps(b+(i+1)*oversample), 1);
+    __m256 in = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load1_ps(a+i)),
+                                     _mm_load1_ps(a+i+1), 1);
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(in, coef));
+  }
+  sum4 = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+  sum4 = _mm_mul_ps(f, sum4);
+  sum4 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+  sum4 = _mm_add_ss(sum4, _mm_shuffle_ps(sum4, sum4, 0x55));
+  _mm_store_ss(&ret, sum4);
+  return ret;
+}
@@ -20,6 +20,12 @@ int moz_speex_have_single_simd() {
 }
 #endif
 
+#ifdef _USE_AVX
+int moz_speex_have_avx() {
+  return mozilla::supports_avx() ? 1 : 0;
+}
+#endif
+
 #ifdef _USE_NEON
 int moz_speex_have_single_simd() {
   return mozilla::supports_neon() ? 1 : 0;
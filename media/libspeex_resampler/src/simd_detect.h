@@ -27,6 +27,16 @@ spx_word32_t inner_product_single(const spx_word16_t *a, const spx_word16_t *b,
 spx_word32_t interpolate_product_single(const spx_word16_t *a, const spx_word16_t *b, unsigned int len, const spx_uint32_t oversample, float *frac);
 #endif
 
+#if defined(_USE_AVX)
+int moz_speex_have_avx();
+#define OVERRIDE_INNER_PRODUCT_SINGLE_AVX
+#define inner_product_single_avx CAT_PREFIX(RANDOM_PREFIX,_inner_product_single_avx)
+float inner_product_single_avx(const float *a, const float *b, unsigned int len);
+#define OVERRIDE_INTERPOLATE_PRODUCT_SINGLE_AVX
+#define interpolate_product_single_avx CAT_PREFIX(RANDOM_PREFIX,_interpolate_product_single_avx)
+float interpolate_product_single_avx(const float *a, const float *b, unsigned int len, const spx_uint32_t oversample, float *frac);
+#endif
+
 #if defined(_USE_SSE2)
 #define OVERRIDE_INNER_PRODUCT_DOUBLE
 #define inner_product_double CAT_PREFIX(RANDOM_PREFIX,_inner_product_double)
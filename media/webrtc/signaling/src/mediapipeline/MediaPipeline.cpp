@@ -1560,25 +1560,59 @@ MediaPipeline::GetTransportInfo_s(TransportLayer* aLayer)
 nsresult
 MediaPipeline::PipelineTransport::SendRtpPacket(const uint8_t* aData, size_t aLen)
 {
-  nsAutoPtr<MediaPacket> packet(new MediaPacket);
-  packet->Copy(aData, aLen, aLen + SRTP_MAX_EXPANSION);
-  packet->SetType(MediaPacket::RTP);
+  MediaPacket packet;
+  packet.Copy(aData, aLen, aLen + SRTP_MAX_EXPANSION);
+  packet.SetType(MediaPacket::RTP);
 
-  RUN_ON_THREAD(
+  return EnqueuePacket(std::move(packet));
+}
+
+nsresult
+MediaPipeline::PipelineTransport::EnqueuePacket(MediaPacket&& aPacket)
+{
+  {
+    MutexAutoLock lock(mMutex);
+    mPendingPackets.push_back(std::move(aPacket));
+    if (mPendingPackets.size() > 1) {
+      // SendPendingPackets_s has been dispatched and not run yet.
+      return NS_OK;
+    }
+  }
+
+  nsresult rv = RUN_ON_THREAD(
     mStsThread,
     WrapRunnable(RefPtr<MediaPipeline::PipelineTransport>(this),
-                 &MediaPipeline::PipelineTransport::SendRtpRtcpPacket_s,
-                 packet),
+                 &MediaPipeline::PipelineTransport::SendPendingPackets_s),
     NS_DISPATCH_NORMAL);
+  if (NS_FAILED(rv)) {
+    // Nothing will drain the queue, so drop it rather than leaving later
+    // packets stuck behind it.
+    MutexAutoLock lock(mMutex);
+    mPendingPackets.clear();
+  }
+  return rv;
+}
 
-  return NS_OK;
+void
+MediaPipeline::PipelineTransport::SendPendingPackets_s()
+{
+  ASSERT_ON_THREAD(mStsThread);
+  MOZ_ASSERT(mSendingPackets.empty());
+  {
+    MutexAutoLock lock(mMutex);
+    mSendingPackets.swap(mPendingPackets);
+  }
+
+  for (MediaPacket& packet : mSendingPackets) {
+    SendRtpRtcpPacket_s(packet);
+  }
+  mSendingPackets.clear();
 }
 
 nsresult
-MediaPipeline::PipelineTransport::SendRtpRtcpPacket_s(
-  nsAutoPtr<MediaPacket> aPacket)
+MediaPipeline::PipelineTransport::SendRtpRtcpPacket_s(MediaPacket& aPacket)
 {
-  bool isRtp = aPacket->type() == MediaPacket::RTP;
+  bool isRtp = aPacket.type() == MediaPacket::RTP;
 
   ASSERT_ON_THREAD(mStsThread);
   if (!mPipeline) {
@@ -1595,7 +1629,7 @@ MediaPipeline::PipelineTransport::SendRtpRtcpPacket_s(
   MOZ_ASSERT(transport.mTransport);
   NS_ENSURE_TRUE(transport.mTransport, NS_ERROR_NULL_POINTER);
 
-  MediaPacket packet(std::move(*aPacket));
+  MediaPacket packet(std::move(aPacket));
   packet.sdp_level() = Some(mPipeline->Level());
 
   if (RtpLogger::IsPacketLoggingOn()) {
@@ -1630,18 +1664,11 @@ nsresult
 MediaPipeline::PipelineTransport::SendRtcpPacket(const uint8_t* aData,
                                                  size_t aLen)
 {
-  nsAutoPtr<MediaPacket> packet(new MediaPacket);
-  packet->Copy(aData, aLen, aLen + SRTP_MAX_EXPANSION);
-  packet->SetType(MediaPacket::RTCP);
+  MediaPacket packet;
+  packet.Copy(aData, aLen, aLen + SRTP_MAX_EXPANSION);
+  packet.SetType(MediaPacket::RTCP);
 
-  RUN_ON_THREAD(
-    mStsThread,
-    WrapRunnable(RefPtr<MediaPipeline::PipelineTransport>(this),
-                 &MediaPipeline::PipelineTransport::SendRtpRtcpPacket_s,
-                 packet),
-    NS_DISPATCH_NORMAL);
-
-  return NS_OK;
+  return EnqueuePacket(std::move(packet));
 }
 
 // Called if we're attached with AddDirectListener()
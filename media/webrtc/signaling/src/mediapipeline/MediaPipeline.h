@@ -9,12 +9,14 @@
 #define mediapipeline_h__
 
 #include <map>
+#include <vector>
 
 #include "sigslot.h"
 
 #include "signaling/src/media-conduit/MediaConduitInterface.h"
 #include "mozilla/ReentrantMonitor.h"
 #include "mozilla/Atomics.h"
+#include "mozilla/Mutex.h"
 #include "SrtpFlow.h"
 #include "mediapacket.h"
 #include "mtransport/runnable_utils.h"
@@ -188,6 +190,7 @@ public:
     explicit PipelineTransport(nsIEventTarget* aStsThread)
       : mPipeline(nullptr)
       , mStsThread(aStsThread)
+      , mMutex("MediaPipeline::PipelineTransport")
     {
     }
 
@@ -199,11 +202,21 @@ public:
     virtual nsresult SendRtcpPacket(const uint8_t* aData, size_t aLen) override;
 
   private:
-    nsresult SendRtpRtcpPacket_s(nsAutoPtr<MediaPacket> aData);
+    // Queues aPacket for the STS thread. Packets queued while a previous
+    // batch is still waiting to run are sent with that batch, so a burst of
+    // packets costs a single dispatch.
+    nsresult EnqueuePacket(MediaPacket&& aPacket);
+    void SendPendingPackets_s();
+    nsresult SendRtpRtcpPacket_s(MediaPacket& aPacket);
 
     // Creates a cycle, which we break with Detach
     RefPtr<MediaPipeline> mPipeline;
     const nsCOMPtr<nsIEventTarget> mStsThread;
+    // mMutex guards mPendingPackets.
+    Mutex mMutex;
+    std::vector<MediaPacket> mPendingPackets;
+    // Batch being sent on the STS thread; kept to reuse its storage.
+    std::vector<MediaPacket> mSendingPackets;
   };
 
 protected:
@@ -316,6 +316,14 @@ WebSocketChannelChild::OnStop(const nsresult& aStatusCode)
   }
 }
 
+// PWebSocket is managed by PNecko, so both text and binary messages arrive on
+// the main thread. RecvOnMessageAvailable and RecvOnBinaryMessageAvailable
+// wrap them in a MessageEvent, and EventTargetDispatcher forwards that to
+// mTargetThread.
+// For WebSocket in workers this is the only main thread hop left on the data
+// path (in the parent process WebSocketChannel dispatches straight to the
+// target); removing it needs the protocol to move to a PBackground-managed
+// actor bound to the worker.
 class MessageEvent : public ChannelEvent
 {
  public:
@@ -214,6 +214,31 @@ nsHtml5TreeOperation::AppendToDocument(nsIContent* aNode,
   return rv;
 }
 
+// Returns how many of aAttributes will be stored in aElement's AttrArray.
+// Mapped attributes of HTML and MathML elements go to nsMappedAttributes
+// instead, so they don't need a slot there.
+static uint32_t
+CountUnmappedAttributes(dom::Element* aElement,
+                        nsHtml5HtmlAttributes* aAttributes)
+{
+  int32_t len = aAttributes->getLength();
+  if (!aElement->IsHTMLElement() && !aElement->IsMathMLElement()) {
+    return len;
+  }
+
+  uint32_t count = 0;
+  for (int32_t i = 0; i < len; i++) {
+    // Mapped attributes are all static atoms, so the local name doesn't need
+    // regetting for this comparison.
+    if (aAttributes->getURINoBoundsCheck(i) != kNameSpaceID_None ||
+        !aElement->IsAttributeMapped(
+          aAttributes->getLocalNameNoBoundsCheck(i))) {
+      count++;
+    }
+  }
+  return count;
+}
+
 static bool
 IsElementOrTemplateContent(nsINode* aNode)
 {
@@ -327,6 +352,8 @@ nsHtml5TreeOperation::SetHTMLElementAttributes(
   nsHtml5HtmlAttributes* aAttributes)
 {
   int32_t len = aAttributes->getLength();
+  aElement->EnsureAttrCapacity(
+    CountUnmappedAttributes(aElement, aAttributes));
   for (int32_t i = 0; i < len; i++) {
     nsHtml5String val = aAttributes->getValueNoBoundsCheck(i);
     nsAtom* klass = val.MaybeAsAtom();
@@ -557,6 +584,8 @@ nsHtml5TreeOperation::CreateSVGElement(
   }
 
   int32_t len = aAttributes->getLength();
+  newContent->EnsureAttrCapacity(
+    CountUnmappedAttributes(newContent, aAttributes));
   for (int32_t i = 0; i < len; i++) {
     nsHtml5String val = aAttributes->getValueNoBoundsCheck(i);
     nsAtom* klass = val.MaybeAsAtom();
@@ -611,6 +640,8 @@ nsHtml5TreeOperation::CreateMathMLElement(nsAtom* aName,
   }
 
   int32_t len = aAttributes->getLength();
+  newContent->EnsureAttrCapacity(
+    CountUnmappedAttributes(newContent, aAttributes));
   for (int32_t i = 0; i < len; i++) {
     nsHtml5String val = aAttributes->getValueNoBoundsCheck(i);
     nsAtom* klass = val.MaybeAsAtom();
@@ -134,17 +134,6 @@ CertIDHash(SHA384Buffer& buf, const CertID& certID,
   return rv;
 }
 
-Result
-OCSPCache::Entry::Init(const CertID& aCertID,
-                       const OriginAttributes& aOriginAttributes)
-{
-  SECStatus srv = CertIDHash(mIDHash, aCertID, aOriginAttributes);
-  if (srv != SECSuccess) {
-    return MapPRErrorCodeToResult(PR_GetError());
-  }
-  return Success;
-}
-
 OCSPCache::OCSPCache()
   : mMutex("OCSPCache-mutex")
 {
@@ -155,34 +144,13 @@ OCSPCache::~OCSPCache()
   Clear();
 }
 
-// Returns false with index in an undefined state if no matching entry was
-// found.
-bool
-OCSPCache::FindInternal(const CertID& aCertID,
-                        const OriginAttributes& aOriginAttributes,
-                        /*out*/ size_t& index,
+// Returns nullptr if no matching entry was found.
+OCSPCache::Entry*
+OCSPCache::FindInternal(const SHA384Buffer& aIDHash,
                         const MutexAutoLock& /* aProofOfLock */)
 {
-  if (mEntries.length() == 0) {
-    return false;
-  }
-
-  SHA384Buffer idHash;
-  SECStatus rv = CertIDHash(idHash, aCertID, aOriginAttributes);
-  if (rv != SECSuccess) {
-    return false;
-  }
-
-  // mEntries is sorted with the most-recently-used entry at the end.
-  // Thus, searching from the end will often be fastest.
-  index = mEntries.length();
-  while (index > 0) {
-    --index;
-    if (memcmp(mEntries[index]->mIDHash, idHash, SHA384_LENGTH) == 0) {
-      return true;
-    }
-  }
-  return false;
+  auto ptr = mEntries.lookup(aIDHash);
+  return ptr ? *ptr : nullptr;
 }
 
 static inline void
@@ -195,16 +163,12 @@ LogWithCertID(const char* aMessage, const CertID& aCertID,
 }
 
 void
-OCSPCache::MakeMostRecentlyUsed(size_t aIndex,
+OCSPCache::MakeMostRecentlyUsed(Entry* aEntry,
                                 const MutexAutoLock& /* aProofOfLock */)
 {
-  Entry* entry = mEntries[aIndex];
-  // Since mEntries is sorted with the most-recently-used entry at the end,
-  // aIndex is likely to be near the end, so this is likely to be fast.
-  mEntries.erase(mEntries.begin() + aIndex);
-  // erase() does not shrink or realloc memory, so the append below should
-  // always succeed.
-  MOZ_RELEASE_ASSERT(mEntries.append(entry));
+  // mEntryList is sorted with the most-recently-used entry at the end.
+  aEntry->remove();
+  mEntryList.insertBack(aEntry);
 }
 
 bool
@@ -212,19 +176,26 @@ OCSPCache::Get(const CertID& aCertID,
                const OriginAttributes& aOriginAttributes,
                Result& aResult, Time& aValidThrough)
 {
+  // Hash outside of the lock so that concurrent verifications only contend
+  // on the table itself.
+  SHA384Buffer idHash;
+  if (CertIDHash(idHash, aCertID, aOriginAttributes) != SECSuccess) {
+    return false;
+  }
+
   MutexAutoLock lock(mMutex);
 
-  size_t index;
-  if (!FindInternal(aCertID, aOriginAttributes, index, lock)) {
+  Entry* entry = FindInternal(idHash, lock);
+  if (!entry) {
     LogWithCertID("OCSPCache::Get(%p,\"%s\") not in cache", aCertID,
                   aOriginAttributes);
     return false;
   }
   LogWithCertID("OCSPCache::Get(%p,\"%s\") in cache", aCertID,
                 aOriginAttributes);
-  aResult = mEntries[index]->mResult;
-  aValidThrough = mEntries[index]->mValidThrough;
-  MakeMostRecentlyUsed(index, lock);
+  aResult = entry->mResult;
+  aValidThrough = entry->mValidThrough;
+  MakeMostRecentlyUsed(entry, lock);
   return true;
 }
 
@@ -233,26 +204,31 @@ OCSPCache::Put(const CertID& aCertID,
                const OriginAttributes& aOriginAttributes,
                Result aResult, Time aThisUpdate, Time aValidThrough)
 {
+  SHA384Buffer idHash;
+  if (CertIDHash(idHash, aCertID, aOriginAttributes) != SECSuccess) {
+    return MapPRErrorCodeToResult(PR_GetError());
+  }
+
   MutexAutoLock lock(mMutex);
 
-  size_t index;
-  if (FindInternal(aCertID, aOriginAttributes, index, lock)) {
+  Entry* entry = FindInternal(idHash, lock);
+  if (entry) {
     // Never replace an entry indicating a revoked certificate.
-    if (mEntries[index]->mResult == Result::ERROR_REVOKED_CERTIFICATE) {
+    if (entry->mResult == Result::ERROR_REVOKED_CERTIFICATE) {
       LogWithCertID("OCSPCache::Put(%p, \"%s\") already in cache as revoked - "
                     "not replacing", aCertID, aOriginAttributes);
-      MakeMostRecentlyUsed(index, lock);
+      MakeMostRecentlyUsed(entry, lock);
       return Success;
     }
 
     // Never replace a newer entry with an older one unless the older entry
     // indicates a revoked certificate, which we want to remember.
-    if (mEntries[index]->mThisUpdate > aThisUpdate &&
+    if (entry->mThisUpdate > aThisUpdate &&
         aResult != Result::ERROR_REVOKED_CERTIFICATE) {
       LogWithCertID("OCSPCache::Put(%p, \"%s\") already in cache with more "
                     "recent validity - not replacing", aCertID,
                     aOriginAttributes);
-      MakeMostRecentlyUsed(index, lock);
+      MakeMostRecentlyUsed(entry, lock);
       return Success;
     }
 
@@ -264,30 +240,30 @@ OCSPCache::Put(const CertID& aCertID,
       LogWithCertID("OCSPCache::Put(%p, \"%s\") already in cache - not "
                     "replacing with less important status", aCertID,
                     aOriginAttributes);
-      MakeMostRecentlyUsed(index, lock);
+      MakeMostRecentlyUsed(entry, lock);
       return Success;
     }
 
     LogWithCertID("OCSPCache::Put(%p, \"%s\") already in cache - replacing",
                   aCertID, aOriginAttributes);
-    mEntries[index]->mResult = aResult;
-    mEntries[index]->mThisUpdate = aThisUpdate;
-    mEntries[index]->mValidThrough = aValidThrough;
-    MakeMostRecentlyUsed(index, lock);
+    entry->mResult = aResult;
+    entry->mThisUpdate = aThisUpdate;
+    entry->mValidThrough = aValidThrough;
+    MakeMostRecentlyUsed(entry, lock);
     return Success;
   }
 
-  if (mEntries.length() == MaxEntries) {
+  if (mEntries.count() == MaxEntries) {
     LogWithCertID("OCSPCache::Put(%p, \"%s\") too full - evicting an entry",
                   aCertID, aOriginAttributes);
-    for (Entry** toEvict = mEntries.begin(); toEvict != mEntries.end();
-         toEvict++) {
+    for (Entry* toEvict : mEntryList) {
       // Never evict an entry that indicates a revoked or unknokwn certificate,
       // because revoked responses are more security-critical to remember.
-      if ((*toEvict)->mResult != Result::ERROR_REVOKED_CERTIFICATE &&
-          (*toEvict)->mResult != Result::ERROR_OCSP_UNKNOWN_CERT) {
-        delete *toEvict;
-        mEntries.erase(toEvict);
+      if (toEvict->mResult != Result::ERROR_REVOKED_CERTIFICATE &&
+          toEvict->mResult != Result::ERROR_OCSP_UNKNOWN_CERT) {
+        mEntries.remove(toEvict->mIDHash);
+        toEvict->remove();
+        delete toEvict;
         break;
       }
     }
@@ -298,28 +274,24 @@ OCSPCache::Put(const CertID& aCertID,
     // security issue. If we're trying to insert a revoked or unknown response,
     // we can't. We should return with an error that causes the current
     // verification to fail.
-    if (mEntries.length() == MaxEntries) {
+    if (mEntries.count() == MaxEntries) {
       return aResult;
     }
   }
 
   Entry* newEntry = new (std::nothrow) Entry(aResult, aThisUpdate,
-                                             aValidThrough);
+                                             aValidThrough, idHash);
   // Normally we don't have to do this in Gecko, because OOM is fatal.
   // However, if we want to embed this in another project, OOM might not
   // be fatal, so handle this case.
   if (!newEntry) {
     return Result::FATAL_ERROR_NO_MEMORY;
   }
-  Result rv = newEntry->Init(aCertID, aOriginAttributes);
-  if (rv != Success) {
-    delete newEntry;
-    return rv;
-  }
-  if (!mEntries.append(newEntry)) {
+  if (!mEntries.putNew(newEntry->mIDHash, newEntry)) {
     delete newEntry;
     return Result::FATAL_ERROR_NO_MEMORY;
   }
+  mEntryList.insertBack(newEntry);
   LogWithCertID("OCSPCache::Put(%p, \"%s\") added to cache", aCertID,
                 aOriginAttributes);
   return Success;
@@ -330,14 +302,11 @@ OCSPCache::Clear()
 {
   MutexAutoLock lock(mMutex);
   MOZ_LOG(gCertVerifierLog, LogLevel::Debug, ("OCSPCache::Clear: clearing cache"));
-  // First go through and delete the memory being pointed to by the pointers
-  // in the vector.
-  for (Entry** entry = mEntries.begin(); entry < mEntries.end();
-       entry++) {
-    delete *entry;
+  // First empty the table of pointers, then delete the entries themselves.
+  mEntries.clearAndCompact();
+  while (Entry* entry = mEntryList.popFirst()) {
+    delete entry;
   }
-  // Then remove the pointers themselves.
-  mEntries.clearAndFree();
 }
 
 } } // namespace mozilla::psm
@@ -25,9 +25,12 @@
 #ifndef mozilla_psm_OCSPCache_h
 #define mozilla_psm_OCSPCache_h
 
+#include <string.h>
+
 #include "hasht.h"
+#include "mozilla/HashTable.h"
+#include "mozilla/LinkedList.h"
 #include "mozilla/Mutex.h"
-#include "mozilla/Vector.h"
 #include "pkix/Result.h"
 #include "pkix/Time.h"
 #include "prerror.h"
@@ -50,7 +53,7 @@ typedef uint8_t SHA384Buffer[SHA384_LENGTH];
 // result is keyed on the certificate that purportedly corresponds to it (where
 // certificates are distinguished based on serial number, issuer, and
 // issuer public key, much like in an encoded OCSP response itself). A maximum
-// of 1024 distinct entries can be stored.
+// of 4096 distinct entries can be stored.
 // OCSPCache is thread-safe.
 class OCSPCache
 {
@@ -91,20 +94,23 @@ public:
   // Removes everything from the cache.
   void Clear();
 
+  // The maximum number of distinct entries the cache holds.
+  static const size_t MaxEntries = 4096;
+
 private:
-  class Entry
+  class Entry : public LinkedListElement<Entry>
   {
   public:
     Entry(mozilla::pkix::Result aResult,
           mozilla::pkix::Time aThisUpdate,
-          mozilla::pkix::Time aValidThrough)
+          mozilla::pkix::Time aValidThrough,
+          const SHA384Buffer& aIDHash)
       : mResult(aResult)
       , mThisUpdate(aThisUpdate)
       , mValidThrough(aValidThrough)
     {
+      memcpy(mIDHash, aIDHash, SHA384_LENGTH);
     }
-    mozilla::pkix::Result Init(const mozilla::pkix::CertID& aCertID,
-                               const OriginAttributes& aOriginAttributes);
 
     mozilla::pkix::Result mResult;
     mozilla::pkix::Time mThisUpdate;
@@ -117,20 +123,34 @@ private:
     SHA384Buffer mIDHash;
   };
 
-  bool FindInternal(const mozilla::pkix::CertID& aCertID,
-                    const OriginAttributes& aOriginAttributes,
-                    /*out*/ size_t& index,
-                    const MutexAutoLock& aProofOfLock);
-  void MakeMostRecentlyUsed(size_t aIndex, const MutexAutoLock& aProofOfLock);
+  // Hashes entries by their mIDHash. Since that is already a cryptographic
+  // hash, its leading bytes are used directly as the table hash.
+  struct EntryHasher
+  {
+    using Lookup = const uint8_t*;
+
+    static HashNumber hash(const Lookup& aLookup)
+    {
+      HashNumber hash;
+      memcpy(&hash, aLookup, sizeof(hash));
+      return hash;
+    }
+
+    static bool match(Entry* const& aEntry, const Lookup& aLookup)
+    {
+      return memcmp(aEntry->mIDHash, aLookup, SHA384_LENGTH) == 0;
+    }
+  };
+
+  Entry* FindInternal(const SHA384Buffer& aIDHash,
+                      const MutexAutoLock& aProofOfLock);
+  void MakeMostRecentlyUsed(Entry* aEntry, const MutexAutoLock& aProofOfLock);
 
   Mutex mMutex;
-  static const size_t MaxEntries = 1024;
-  // Sorted with the most-recently-used entry at the end.
-  // Using 256 here reserves as much possible inline storage as the vector
-  // implementation will give us. 1024 bytes is the maximum it allows,
-  // which results in 256 Entry pointers or 128 Entry pointers, depending
-  // on the size of a pointer.
-  Vector<Entry*, 256> mEntries;
+  // Entries keyed by mIDHash, for constant time lookups.
+  HashSet<Entry*, EntryHasher> mEntries;
+  // The same entries, with the most-recently-used entry at the end.
+  LinkedList<Entry> mEntryList;
 };
 
 } } // namespace mozilla::psm
@@ -31,7 +31,7 @@ LiteralInput(const char(&valueString)[N])
   return Input(reinterpret_cast<const uint8_t(&)[N - 1]>(valueString));
 }
 
-const int MaxCacheEntries = 1024;
+const int MaxCacheEntries = mozilla::psm::OCSPCache::MaxEntries;
 
 class psm_OCSPCacheTest : public ::testing::Test
 {
@@ -128,9 +128,13 @@ TEST_F(psm_OCSPCacheTest, TestVariousGets)
   ASSERT_EQ(Success, resultOut);
   ASSERT_EQ(timeInPlus512, timeOut);
 
-  // We've never seen this certificate
-  static const Input fakeSerial1111(LiteralInput("1111"));
-  ASSERT_FALSE(cache.Get(CertID(fakeIssuer1, fakeKey000, fakeSerial1111),
+  // We've never seen this certificate (the loop above stopped short of it)
+  uint8_t unseenSerialBuf[8];
+  snprintf(mozilla::BitwiseCast<char*, uint8_t*>(unseenSerialBuf),
+           sizeof(unseenSerialBuf), "%04d", MaxCacheEntries);
+  Input fakeSerialUnseen;
+  ASSERT_EQ(Success, fakeSerialUnseen.Init(unseenSerialBuf, 4));
+  ASSERT_FALSE(cache.Get(CertID(fakeIssuer1, fakeKey000, fakeSerialUnseen),
                          OriginAttributes(), resultOut, timeOut));
 }
 
@@ -203,30 +207,30 @@ TEST_F(psm_OCSPCacheTest, TestEverythingIsRevoked)
     PutAndGet(cache, CertID(fakeIssuer1, fakeKey000, fakeSerial),
               Result::ERROR_REVOKED_CERTIFICATE, timeIn);
   }
-  static const Input fakeSerial1025(LiteralInput("1025"));
-  CertID good(fakeIssuer1, fakeKey000, fakeSerial1025);
+  static const Input fakeSerialGood(LiteralInput("good"));
+  CertID good(fakeIssuer1, fakeKey000, fakeSerialGood);
   // This will "succeed", allowing verification to continue. However,
   // nothing was actually put in the cache.
-  Time timeInPlus1025(timeIn);
-  ASSERT_EQ(Success, timeInPlus1025.AddSeconds(1025));
-  Time timeInPlus1025Minus50(timeInPlus1025);
-  ASSERT_EQ(Success, timeInPlus1025Minus50.SubtractSeconds(50));
-  Result result = cache.Put(good, OriginAttributes(), Success, timeInPlus1025Minus50,
-                            timeInPlus1025);
+  Time timeInPlusMaxPlus1(timeIn);
+  ASSERT_EQ(Success, timeInPlusMaxPlus1.AddSeconds(MaxCacheEntries + 1));
+  Time timeInPlusMaxPlus1Minus50(timeInPlusMaxPlus1);
+  ASSERT_EQ(Success, timeInPlusMaxPlus1Minus50.SubtractSeconds(50));
+  Result result = cache.Put(good, OriginAttributes(), Success, timeInPlusMaxPlus1Minus50,
+                            timeInPlusMaxPlus1);
   ASSERT_EQ(Success, result);
   Result resultOut;
   Time timeOut(Time::uninitialized);
   ASSERT_FALSE(cache.Get(good, OriginAttributes(), resultOut, timeOut));
 
-  static const Input fakeSerial1026(LiteralInput("1026"));
-  CertID revoked(fakeIssuer1, fakeKey000, fakeSerial1026);
+  static const Input fakeSerialRevoked(LiteralInput("revoked"));
+  CertID revoked(fakeIssuer1, fakeKey000, fakeSerialRevoked);
   // This will fail, causing verification to fail.
-  Time timeInPlus1026(timeIn);
-  ASSERT_EQ(Success, timeInPlus1026.AddSeconds(1026));
-  Time timeInPlus1026Minus50(timeInPlus1026);
-  ASSERT_EQ(Success, timeInPlus1026Minus50.SubtractSeconds(50));
+  Time timeInPlusMaxPlus2(timeIn);
+  ASSERT_EQ(Success, timeInPlusMaxPlus2.AddSeconds(MaxCacheEntries + 2));
+  Time timeInPlusMaxPlus2Minus50(timeInPlusMaxPlus2);
+  ASSERT_EQ(Success, timeInPlusMaxPlus2Minus50.SubtractSeconds(50));
   result = cache.Put(revoked, OriginAttributes(), Result::ERROR_REVOKED_CERTIFICATE,
-                     timeInPlus1026Minus50, timeInPlus1026);
+                     timeInPlusMaxPlus2Minus50, timeInPlusMaxPlus2);
   ASSERT_EQ(Result::ERROR_REVOKED_CERTIFICATE, result);
 }
 
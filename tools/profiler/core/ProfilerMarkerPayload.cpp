@@ -129,6 +129,17 @@ LayerTranslationMarkerPayload::StreamPayload(SpliceableJSONWriter& aWriter,
   aWriter.IntProperty("y", mPoint.y);
 }
 
+void
+WebRenderDisplayListReusedMarkerPayload::StreamPayload(
+  SpliceableJSONWriter& aWriter,
+  const TimeStamp& aProcessStartTime,
+  UniqueStacks& aUniqueStacks)
+{
+  StreamCommonProps("WebRenderDisplayListReused", aWriter, aProcessStartTime,
+                    aUniqueStacks);
+  aWriter.DoubleProperty("savedBuildTime", mSavedBuildTime.ToMilliseconds());
+}
+
 void
 VsyncMarkerPayload::StreamPayload(SpliceableJSONWriter& aWriter,
                                   const TimeStamp& aProcessStartTime,
@@ -192,6 +192,24 @@ private:
   mozilla::gfx::Point mPoint;
 };
 
+// Marks a paint that reused the retained WebRender display list instead of
+// building a new one, along with how long that build took last time.
+class WebRenderDisplayListReusedMarkerPayload : public ProfilerMarkerPayload
+{
+public:
+  WebRenderDisplayListReusedMarkerPayload(
+    const mozilla::TimeDuration& aSavedBuildTime,
+    const mozilla::TimeStamp& aTime)
+    : ProfilerMarkerPayload(aTime, aTime)
+    , mSavedBuildTime(aSavedBuildTime)
+  {}
+
+  DECL_STREAM_PAYLOAD
+
+private:
+  mozilla::TimeDuration mSavedBuildTime;
+};
+
 #include "Units.h"    // For ScreenIntPoint
 
 // Tracks when a vsync occurs according to the HardwareComposer.
@@ -2093,6 +2093,9 @@ private:
   bool mMergeZones;
   nsAutoPtr<NodePool::Enumerator> mCurrNode;
   uint32_t mNoteChildCount;
+  // The merged zone most recently noted as a child of mCurrPi. Used to avoid
+  // adding redundant edges from one node to the same zone node.
+  JS::Zone* mLastMergedZoneChild;
 
   struct PtrInfoCache : public MruCache<void*, PtrInfo*, PtrInfoCache, 491>
   {
@@ -2138,6 +2141,7 @@ private:
   void SetFirstChild()
   {
     mCurrPi->SetFirstChild(mEdgeBuilder.Mark());
+    mLastMergedZoneChild = nullptr;
   }
 
   void SetLastChild()
@@ -2226,6 +2230,7 @@ CCGraphBuilder::CCGraphBuilder(CCGraph& aGraph,
   , mLogger(aLogger)
   , mMergeZones(aMergeZones)
   , mNoteChildCount(0)
+  , mLastMergedZoneChild(nullptr)
 {
   // 4096 is an allocation bucket size.
   static_assert(sizeof(CCGraphBuilder) <= 4096,
@@ -2491,6 +2496,14 @@ CCGraphBuilder::NoteJSChild(const JS::GCCellPtr& aChild)
 
   if (GCThingIsGrayCCThing(aChild) || MOZ_UNLIKELY(WantAllTraces())) {
     if (JS::Zone* zone = MergeZone(aChild)) {
+      // Every gray thing in a merged zone is represented by the single zone
+      // node, so a JS holder with many children in one zone would otherwise
+      // add one identical edge per child. Extra edges to a GCed node don't
+      // affect the result, so skip them unless a logger wants every edge.
+      if (zone == mLastMergedZoneChild && MOZ_LIKELY(!mLogger)) {
+        return;
+      }
+      mLastMergedZoneChild = zone;
       NoteChild(zone, mJSZoneParticipant, edgeName);
     } else {
       NoteChild(aChild.asCell(), mJSParticipant, edgeName);
@@ -2908,10 +2921,17 @@ public:
       }
       return true;
     }
+    // An entry whose object is no longer purple was AddRef'd since it was
+    // suspected, so it can be dropped without looking up its participant
+    // or running CanSkip.
+    if (!aEntry->mRefCnt->IsPurple()) {
+      aBuffer.Remove(aEntry);
+      return true;
+    }
     void* o = aEntry->mObject;
     nsCycleCollectionParticipant* cp = aEntry->mParticipant;
     ToParticipant(o, &cp);
-    if (aEntry->mRefCnt->IsPurple() && !cp->CanSkip(o, false) &&
+    if (!cp->CanSkip(o, false) &&
         (!mRemoveChildlessNodes || MayHaveChild(o, cp))) {
       return true;
     }